@@ -0,0 +1,246 @@
+/*******************************************************************************
+ * NAME:	    bom-test.c
+ *
+ * AUTHOR:	    Ethan D. Twardy
+ *
+ * DESCRIPTION:	    Tests for iec_rtod() and the binary BOM format in
+ *		    iecbom.c. Exits with a non-zero status if any check fails.
+ *
+ * CREATED:	    10/19/2026
+ *
+ * LAST EDITED:	    10/19/2026
+ ***/
+
+/*******************************************************************************
+ * INCLUDES
+ ***/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <errno.h>
+#include <unistd.h>
+
+#include "iec60062.h"
+#include "iecbom.h"
+
+/*******************************************************************************
+ * STATIC VARIABLES
+ ***/
+
+static int failures = 0;
+
+/*******************************************************************************
+ * STATIC FUNCTION PROTOTYPES
+ ***/
+
+static void check(const char * name, double got, double expected);
+static void tempfile(char * path, const void * data, size_t length);
+
+/*******************************************************************************
+ * MAIN
+ ***/
+
+int main() {
+
+  /* iec_rtod(): string, value, tolerance, type. NaN tolerance is unknown */
+  const struct {
+    const char * rvalue;
+    double value;
+    double tolerance;
+    int type;
+  } rvalues[] = {
+    {"4K7J", 4700.0, 5.0, IEC_RESISTOR},
+    {"R47", 0.47, NAN, IEC_RESISTOR},
+    {"4KK", 4000.0, 10.0, IEC_RESISTOR},
+    {"1M0M", 1e6, 20.0, IEC_RESISTOR},
+    {"0R", 0.0, NAN, IEC_RESISTOR},
+    {"2n2", 2.2e-9, NAN, IEC_CAP_OR_IND},
+    {"p47", 0.47e-12, NAN, IEC_CAP_OR_IND},
+    {"4\xc2\xb5" "7F", 4.7e-6, 1.0, IEC_CAP_OR_IND},
+    {"4u7F", 4.7e-6, 1.0, IEC_CAP_OR_IND},
+    {"4.7K", -1.0, NAN, -1},
+    {"10", -1.0, NAN, -1},
+    {"K", -1.0, NAN, -1},
+    {"", -1.0, NAN, -1},
+    {"4K7JX", -1.0, NAN, -1},
+    {"4K7X", -1.0, NAN, -1},
+    {"4K7 ", -1.0, NAN, -1},
+    {"4K7K7", -1.0, NAN, -1}
+  };
+  for (size_t i = 0; i < sizeof(rvalues) / sizeof(rvalues[0]); i++) {
+    double tolerance = -2.0;
+    int type = -1;
+    double value = iec_rtod(rvalues[i].rvalue, &tolerance, &type);
+    check(rvalues[i].rvalue, value, rvalues[i].value);
+    if (rvalues[i].value < 0.0) {
+      check(rvalues[i].rvalue, value < 0.0, 1);
+      continue;
+    }
+    if (isnan(rvalues[i].tolerance))
+      check(rvalues[i].rvalue, isnan(tolerance), 1);
+    else
+      check(rvalues[i].rvalue, tolerance, rvalues[i].tolerance);
+    check(rvalues[i].rvalue, type, rvalues[i].type);
+  }
+
+  /* An unknown tolerance is rejected rather than rounded to E192 */
+  check("iec_etold NaN", iec_etold(2.2e-9, NAN, IEC_ROUND_NEAR), -1.0);
+
+  /* Round trip through the binary format */
+  const char text[] = "# comment\n4K7J\n\n  R47F  trailing words\n2n2\n1M0M\n";
+  const double values[] = { 4700.0, 0.47, 2.2e-9, 1e6 };
+  const double tolerances[] = { 5.0, 1.0, NAN, 20.0 };
+  const int types[] = { IEC_RESISTOR, IEC_RESISTOR, IEC_CAP_OR_IND,
+			IEC_RESISTOR };
+  char textpath[] = "/tmp/bom-test-XXXXXX", binpath[] = "/tmp/bom-test-XXXXXX";
+  tempfile(textpath, text, strlen(text));
+  tempfile(binpath, NULL, 0);
+
+  size_t line = 0;
+  check("iec_bom_convert", iec_bom_convert(textpath, binpath, &line), 4);
+  struct iec_bom * bom = iec_bom_open(binpath, IEC_BOM_SHARED);
+  check("iec_bom_open", bom != NULL, 1);
+  if (bom != NULL) {
+    check("count", bom->count, 4);
+    for (size_t i = 0; i < 4 && i < bom->count; i++) {
+      check("value", bom->value[i], values[i]);
+      if (isnan(tolerances[i]))
+	check("tolerance", isnan(bom->tolerance[i]), 1);
+      else
+	check("tolerance", bom->tolerance[i], tolerances[i]);
+      check("type", bom->type[i], types[i]);
+      check("rounded", bom->rounded[i], 0.0);
+    }
+    check("iec_etold_batch", iec_etold_batch(bom->value, bom->tolerance,
+					     bom->rounded, bom->count,
+					     IEC_ROUND_UP), 3);
+    iec_bom_close(bom);
+  }
+
+  /* The shared mapping writes the rounded column back */
+  bom = iec_bom_open(binpath, IEC_BOM_PRIVATE);
+  check("iec_bom_open", bom != NULL, 1);
+  if (bom != NULL) {
+    check("rounded", bom->rounded[0], 4700.0);
+    check("rounded", bom->rounded[1], 0.475);
+    check("rounded", bom->rounded[2], -1.0);
+    check("rounded", bom->rounded[3], 1e6);
+    iec_bom_close(bom);
+  }
+
+  /* A bad line is reported by number */
+  const char bad[] = "4K7\n\n4.7K\n";
+  tempfile(textpath, bad, strlen(bad));
+  check("iec_bom_convert bad", iec_bom_convert(textpath, binpath, &line), -1);
+  check("iec_bom_convert bad line", line, 3);
+
+  /* An empty text file makes an empty BOM */
+  tempfile(textpath, NULL, 0);
+  check("iec_bom_convert empty", iec_bom_convert(textpath, binpath, NULL), 0);
+  bom = iec_bom_open(binpath, IEC_BOM_PRIVATE);
+  check("iec_bom_open empty", bom != NULL, 1);
+  if (bom != NULL)
+    check("count empty", bom->count, 0);
+  iec_bom_close(bom);
+
+  /* Truncated and corrupt files are rejected */
+  struct iec_bom_header header;
+  FILE * file = fopen(binpath, "rb");
+  check("header", fread(&header, sizeof(header), 1, file), 1);
+  fclose(file);
+
+  tempfile(binpath, &header, sizeof(header) - 1);
+  errno = 0;
+  check("iec_bom_open truncated",
+	iec_bom_open(binpath, IEC_BOM_PRIVATE) == NULL, 1);
+  check("errno truncated", errno, EINVAL);
+
+  struct iec_bom_header corrupt = header;
+  corrupt.magic[0] = 'X';
+  tempfile(binpath, &corrupt, sizeof(corrupt));
+  check("iec_bom_open magic",
+	iec_bom_open(binpath, IEC_BOM_PRIVATE) == NULL, 1);
+
+  corrupt = header;
+  corrupt.count = 1;
+  tempfile(binpath, &corrupt, sizeof(corrupt));
+  check("iec_bom_open count",
+	iec_bom_open(binpath, IEC_BOM_PRIVATE) == NULL, 1);
+
+  corrupt = header;
+  corrupt.rounded = 3;
+  tempfile(binpath, &corrupt, sizeof(corrupt));
+  check("iec_bom_open offset",
+	iec_bom_open(binpath, IEC_BOM_PRIVATE) == NULL, 1);
+
+  unlink(textpath);
+  unlink(binpath);
+  printf("%d failures\n", failures);
+  return failures != 0;
+}
+
+/*******************************************************************************
+ * STATIC FUNCTIONS
+ ***/
+
+/*******************************************************************************
+ * FUNCTION:	    check
+ *
+ * DESCRIPTION:	    Compare `got' with `expected' exactly, and report a failure
+ *		    if they differ.
+ *
+ * ARGUMENTS:	    name: (const char *) -- the name of the check.
+ *		    got: (double) -- the value computed.
+ *		    expected: (double) -- the value expected.
+ *
+ * RETURN:	    void.
+ *
+ * NOTES:	    none.
+ ***/
+static void check(const char * name, double got, double expected)
+{
+  if (got == expected)
+    return;
+
+  printf("FAIL %s: got %.17g, expected %.17g\n", name, got, expected);
+  failures++;
+}
+
+/*******************************************************************************
+ * FUNCTION:	    tempfile
+ *
+ * DESCRIPTION:	    Write `length' bytes of `data' to the file at `path.' If
+ *		    `path' ends in XXXXXX, a new temporary file is created and
+ *		    its name is placed in `path.'
+ *
+ * ARGUMENTS:	    path: (char *) -- the path, or mkstemp() template.
+ *		    data: (const void *) -- the data to write.
+ *		    length: (size_t) -- the number of bytes to write.
+ *
+ * RETURN:	    void.
+ *
+ * NOTES:	    Exits if the file cannot be written.
+ ***/
+static void tempfile(char * path, const void * data, size_t length)
+{
+  size_t n = strlen(path);
+  if (n >= 6 && !strcmp(path + n - 6, "XXXXXX")) {
+    int fd = mkstemp(path);
+    if (fd == -1) {
+      perror(path);
+      exit(1);
+    }
+    close(fd);
+  }
+
+  FILE * file = fopen(path, "wb");
+  if (file == NULL || fwrite(data, 1, length, file) != length) {
+    perror(path);
+    exit(1);
+  }
+  fclose(file);
+}
+
+/******************************************************************************/
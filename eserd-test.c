@@ -0,0 +1,157 @@
+/*******************************************************************************
+ * NAME:	    eserd-test.c
+ *
+ * AUTHOR:	    Ethan D. Twardy
+ *
+ * DESCRIPTION:	    Known-answer tests for gnp10(), iec_eserd() and the batch
+ *		    rounding functions. Exits with a non-zero status if any
+ *		    check fails.
+ *
+ * CREATED:	    10/19/2026
+ *
+ * LAST EDITED:	    10/19/2026
+ ***/
+
+/*******************************************************************************
+ * INCLUDES
+ ***/
+
+#include <stdio.h>
+#include <math.h>
+
+#include "iec60062.c" /* gnp10() */
+
+/*******************************************************************************
+ * STATIC VARIABLES
+ ***/
+
+static int failures = 0;
+
+/*******************************************************************************
+ * STATIC FUNCTION PROTOTYPES
+ ***/
+
+static void check(const char * name, double got, double expected);
+
+/*******************************************************************************
+ * MAIN
+ ***/
+
+int main() {
+
+  /* gnp10() across decade edges, where log10() may round the wrong way */
+  const double exponents[][2] = {
+    {1e-12, -12},
+    {4.7e-12, -12},
+    {999999999.9, 8},
+    {1e9, 9},
+    {0.001, -3},
+    {1e22, 22},
+    {1e23, 22}, /* The nearest double is just below 10 ^ 23 */
+    {5e-308, -308},
+    {1.7e308, 308}
+  };
+  for (size_t i = 0; i < sizeof(exponents) / sizeof(exponents[0]); i++)
+    check("gnp10", gnp10(exponents[i][0]), exponents[i][1]);
+  check("gnp10", isnan(gnp10(0.0)), 1);
+  check("gnp10", isnan(gnp10(-1.0)), 1);
+
+  /* iec_eserd(): value, series, direction, expected */
+  const struct {
+    double value;
+    int series;
+    int direction;
+    double expected;
+  } rounds[] = {
+    {4.7e-12, IEC_E12, IEC_ROUND_NEAR, 4.7e-12},
+    {4.7e-12, IEC_E12, IEC_ROUND_UP, 4.7e-12},
+    {4.7e-12, IEC_E12, IEC_ROUND_DOWN, 4.7e-12},
+    {2.2e9, IEC_E6, IEC_ROUND_NEAR, 2.2e9},
+    {9.99e8, IEC_E12, IEC_ROUND_NEAR, 1e9},
+    {999999999.9, IEC_E12, IEC_ROUND_UP, 1e9},
+    {999999999.9, IEC_E12, IEC_ROUND_DOWN, 8.2e8},
+    {1.0000000001, IEC_E12, IEC_ROUND_UP, 1.2},
+    {1.0000000001, IEC_E12, IEC_ROUND_DOWN, 1.0},
+    {1.0000000001, IEC_E12, IEC_ROUND_NEAR, 1.0},
+    {4.4, IEC_E12, IEC_ROUND_DOWN, 3.9},
+    {4.4, IEC_E12, IEC_ROUND_UP, 4.7},
+    {4.2, IEC_E12, IEC_ROUND_NEAR, 3.9}, /* Geometric mean is 4.28 */
+    {4.3, IEC_E12, IEC_ROUND_NEAR, 4.7},
+    {9.5, IEC_E12, IEC_ROUND_UP, 10.0},
+    {0.47, IEC_E96, IEC_ROUND_UP, 0.475},
+    {5e-308, IEC_E12, IEC_ROUND_NEAR, 4.7e-308},
+    {1e27, IEC_E12, IEC_ROUND_DOWN, 1e27}, /* Beyond exact powers of ten */
+    {2.2e-21, IEC_E12, IEC_ROUND_UP, 2.2e-21},
+    {4.7e25, IEC_E12, IEC_ROUND_NEAR, 4.7e25},
+    {8.2e-300, IEC_E12, IEC_ROUND_UP, 8.2e-300},
+    {1.5e300, IEC_E12, IEC_ROUND_DOWN, 1.5e300},
+    {1.7e308, IEC_E12, IEC_ROUND_DOWN, 1.5e308},
+    {1.7e308, IEC_E12, IEC_ROUND_UP, -1.0}, /* Overflows */
+    {1.7e308, IEC_E12, IEC_ROUND_NEAR, -1.0},
+    {0.0, IEC_E12, IEC_ROUND_NEAR, -1.0},
+    {-4.7, IEC_E12, IEC_ROUND_NEAR, -1.0},
+    {NAN, IEC_E12, IEC_ROUND_NEAR, -1.0},
+    {INFINITY, IEC_E12, IEC_ROUND_NEAR, -1.0},
+    {4.7, IEC_R10, IEC_ROUND_NEAR, -1.0},
+    {4.7, IEC_E12, 0, -1.0}
+  };
+  for (size_t i = 0; i < sizeof(rounds) / sizeof(rounds[0]); i++)
+    check("iec_eserd", iec_eserd(rounds[i].value, rounds[i].series,
+				 rounds[i].direction), rounds[i].expected);
+  check("iec_eser", iec_eser(4.4F, IEC_E12, IEC_ROUND_DOWN), 3.9F);
+
+  /* Batch: failures are -1, and only successes are counted */
+  double values[] = { 4.7e3, -1.0, 2.2e-9, 0.0, 1.7e308 };
+  double rounded[5];
+  double expected[] = { 4.7e3, -1.0, 2.2e-9, -1.0, -1.0 };
+  check("iec_eserd_batch count",
+	iec_eserd_batch(values, rounded, 5, IEC_E12, IEC_ROUND_NEAR), 2);
+  for (int i = 0; i < 5; i++)
+    check("iec_eserd_batch", rounded[i], expected[i]);
+
+  rounded[0] = 123.0;
+  check("iec_eserd_batch bad series",
+	iec_eserd_batch(values, rounded, 5, IEC_R10, IEC_ROUND_NEAR), 0);
+  check("iec_eserd_batch bad series", rounded[0], 123.0);
+
+  /* In place, with tolerances */
+  double inplace[] = { 4.4, 4.4, 4.4 };
+  const double tolerances[] = { 10.0, 20.0, 1.0 };
+  check("iec_etold_batch count",
+	iec_etold_batch(inplace, tolerances, inplace, 3, IEC_ROUND_UP), 3);
+  check("iec_etold_batch", inplace[0], 4.7);
+  check("iec_etold_batch", inplace[1], 4.7);
+  check("iec_etold_batch", inplace[2], 4.42);
+
+  printf("%d failures\n", failures);
+  return failures != 0;
+}
+
+/*******************************************************************************
+ * STATIC FUNCTIONS
+ ***/
+
+/*******************************************************************************
+ * FUNCTION:	    check
+ *
+ * DESCRIPTION:	    Compare `got' with `expected' exactly, and report a failure
+ *		    if they differ.
+ *
+ * ARGUMENTS:	    name: (const char *) -- the name of the check.
+ *		    got: (double) -- the value computed.
+ *		    expected: (double) -- the value expected.
+ *
+ * RETURN:	    void.
+ *
+ * NOTES:	    none.
+ ***/
+static void check(const char * name, double got, double expected)
+{
+  if (got == expected)
+    return;
+
+  printf("FAIL %s: got %.17g, expected %.17g\n", name, got, expected);
+  failures++;
+}
+
+/******************************************************************************/
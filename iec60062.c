@@ -9,7 +9,7 @@
  *
  * CREATED:	    11/07/2017
  *
- * LAST EDITED:	    11/19/2017
+ * LAST EDITED:	    10/19/2026
  ***/
 
 /*******************************************************************************
@@ -17,7 +17,10 @@
  ***/
 
 #include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
 #include <math.h>
+#include <float.h>
 
 #include "iec60062.h"
 
@@ -28,24 +31,58 @@
 /* TODO: Add Rener series values */
 /* TODO: int modified_bs(bst * tree, void * data, bst * left, bst * right); */
 
+/* Powers of ten which are exactly representable in a double */
+static const double p10[] = {
+  1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,  1e8,  1e9,  1e10, 1e11,
+  1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+};
+
+/* Multiplier letters used in "R" notation, in place of the decimal point */
+static const struct {
+  const char * code;
+  int exponent;
+  int type;
+} multipliers[] = {
+  { "R", 0, IEC_RESISTOR },
+  { "K", 3, IEC_RESISTOR },
+  { "M", 6, IEC_RESISTOR },
+  { "G", 9, IEC_RESISTOR },
+  { "T", 12, IEC_RESISTOR },
+  { "p", -12, IEC_CAP_OR_IND },
+  { "n", -9, IEC_CAP_OR_IND },
+  { "u", -6, IEC_CAP_OR_IND },
+  { "\xc2\xb5", -6, IEC_CAP_OR_IND }, /* Micro sign, UTF-8 */
+  { "m", -3, IEC_CAP_OR_IND }
+};
+
+/* Tolerance letter codes, in percent */
+static const struct {
+  char code;
+  double tolerance;
+} tolerances[] = {
+  { 'L', 0.01 }, { 'P', 0.02 }, { 'W', 0.05 }, { 'B', 0.1 },
+  { 'C', 0.25 }, { 'D', 0.5 },  { 'F', 1.0 },  { 'G', 2.0 },
+  { 'J', 5.0 },  { 'K', 10.0 }, { 'M', 20.0 }, { 'N', 30.0 }
+};
+
 /* E series values */
-static const float e3[] = { 1.0, 2.2, 4.7 };
-static const float e6[] = { 1.0, 1.5, 2.2, 3.3, 4.7, 6.8 };
-static const float e12[] = {
+static const double e3[] = { 1.0, 2.2, 4.7 };
+static const double e6[] = { 1.0, 1.5, 2.2, 3.3, 4.7, 6.8 };
+static const double e12[] = {
   1.0, 1.2, 1.5, 1.8, 2.2, 2.7, 3.3, 3.9, 4.7, 5.6, 6.8, 8.2
 };
-static const float e24[] = {
+static const double e24[] = {
   1.0, 1.1, 1.2, 1.3, 1.5, 1.6, 1.8, 2.0, 2.2, 2.4, 2.7, 3.0,
   3.3, 3.6, 3.9, 4.3, 4.7, 5.1, 5.6, 6.2, 6.8, 7.5, 8.2, 9.1
 };
-static const float e48[] = {
+static const double e48[] = {
   1.00, 1.05, 1.10, 1.15, 1.21, 1.27, 1.33, 1.40, 1.47, 1.54,
   1.62, 1.69, 1.78, 1.87, 1.96, 2.05, 2.15, 2.26, 2.37, 2.49,
   2.61, 2.74, 2.87, 3.01, 3.16, 3.32, 3.48, 3.65, 3.83, 4.02,
   4.22, 4.42, 4.64, 4.87, 5.11, 5.36, 5.62, 5.90, 6.19, 6.49,
   6.81, 7.15, 7.50, 7.87, 8.25, 8.66, 9.09, 9.53
 };
-static const float e96[] = {
+static const double e96[] = {
   1.00, 1.02, 1.05, 1.07, 1.10, 1.13, 1.15, 1.18, 1.21, 1.24,
   1.27, 1.30, 1.33, 1.37, 1.40, 1.43, 1.47, 1.50, 1.54, 1.58,
   1.62, 1.65, 1.69, 1.74, 1.78, 1.82, 1.87, 1.91, 1.96, 2.00,
@@ -57,7 +94,7 @@ static const float e96[] = {
   6.81, 6.98, 7.15, 7.32, 7.50, 7.68, 7.87, 8.06, 8.25, 8.45,
   8.66, 8.87, 9.09, 9.31, 9.53, 9.76
 };
-static const float e192[] = {
+static const double e192[] = {
   1.00, 1.01, 1.02, 1.04, 1.05, 1.06, 1.07, 1.09, 1.10, 1.11,
   1.13, 1.14, 1.15, 1.17, 1.18, 1.20, 1.21, 1.23, 1.24, 1.26,
   1.27, 1.29, 1.30, 1.32, 1.33, 1.35, 1.37, 1.38, 1.40, 1.42,
@@ -84,8 +121,14 @@ static const float e192[] = {
  * STATIC FUNCTION PROTOTYPES
  ***/
 
-static float gnp10(float value);
-static float stdvalue(float value, float * array, size_t size, int direction);
+static double gnp10(double value);
+static double scale10(double value, int exponent);
+static double stdvalue(double value, const double * array, size_t size,
+		       int direction);
+static double entry(const double * array, long size, long index,
+		    int exponent);
+static const double * eseries(int series, size_t * size);
+static int etolseries(double tolerance);
 
 /*******************************************************************************
  * API FUNCTIONS
@@ -131,12 +174,95 @@ char * iec_rtostr(float value, float tolerance, int type)
  *			occurred.
  *
  * NOTES:	    Since inductors and capacitors have the same "R" notation,
- *		    if this notation is encountered, *type is set to the bitwise
- *		    OR of C_INDUCTOR and C_RESISTOR
+ *		    if this notation is encountered, *type is set to
+ *		    IEC_CAP_OR_IND. The parsing is carried out by iec_rtod().
  ***/
 float iec_rtof(char * rvalue, float * tolerance, int * type)
 {
-  return -1.0F; /* TODO: Implement rtof */
+  double tol = NAN;
+  float value = (float)iec_rtod(rvalue, &tol, type);
+  if (tolerance != NULL)
+    *tolerance = (float)tol;
+  return value;
+}
+
+/*******************************************************************************
+ * FUNCTION:	    iec_rtod
+ *
+ * DESCRIPTION:	    This function converts the "R" notation string in `rvalue'
+ *		    to a component value and tolerance, in double precision.
+ *		    e.g. "4K7J" is 4700 Ohm, 5%; "2n2" is 2.2 nF.
+ *
+ * ARGUMENTS:	    rvalue: (const char *) -- the "R" notation string.
+ *		    tolerance: (double *) -- location to place the value of the
+ *			component's tolerance, in percent, after the function
+ *			call. Set to NaN if `rvalue' has no tolerance code. May
+ *			be NULL.
+ *		    type: (int *) -- the type of component. One of the type
+ *			macros defined in iec60062.h. Type is placed here on
+ *			return. May be NULL.
+ *
+ * RETURN:	    double -- components value, or less than 0 if an error
+ *			occurred.
+ *
+ * NOTES:	    The multiplier letters R, K, M, G and T denote a resistor.
+ *		    The letters p, n, u (or the micro sign) and m denote a
+ *		    capacitor or inductor, and *type is set to IEC_CAP_OR_IND.
+ ***/
+double iec_rtod(const char * rvalue, double * tolerance, int * type)
+{
+  if (rvalue == NULL)
+    return -1.0;
+
+  unsigned long long mantissa = 0;
+  int digits = 0, fraction = 0, exponent = 0, kind = -1;
+  double tol = NAN;
+  const char * c = rvalue;
+  for (; *c != '\0'; c++) {
+    if (*c >= '0' && *c <= '9') {
+      if (digits >= 18)
+	return -1.0;
+      mantissa = mantissa * 10 + (*c - '0');
+      if (kind != -1)
+	fraction++;
+      digits++;
+      continue;
+    }
+
+    if (kind != -1)
+      break;
+    size_t i = 0;
+    for (; i < sizeof(multipliers) / sizeof(multipliers[0]); i++) {
+      if (!strncmp(c, multipliers[i].code, strlen(multipliers[i].code)))
+	break;
+    }
+    if (i == sizeof(multipliers) / sizeof(multipliers[0]))
+      return -1.0;
+    exponent = multipliers[i].exponent;
+    kind = multipliers[i].type;
+    c += strlen(multipliers[i].code) - 1;
+  }
+
+  /* Anything left over must be exactly one tolerance code */
+  if (*c != '\0') {
+    size_t i = 0;
+    for (; i < sizeof(tolerances) / sizeof(tolerances[0]); i++) {
+      if (*c == tolerances[i].code)
+	break;
+    }
+    if (i == sizeof(tolerances) / sizeof(tolerances[0]) || c[1] != '\0')
+      return -1.0;
+    tol = tolerances[i].tolerance;
+  }
+
+  if (kind == -1 || digits == 0)
+    return -1.0;
+
+  if (tolerance != NULL)
+    *tolerance = tol;
+  if (type != NULL)
+    *type = kind;
+  return scale10((double)mantissa, exponent - fraction);
 }
 
 /*******************************************************************************
@@ -174,38 +300,11 @@ float iec_renard(float value, int series, int direction)
  *
  * RETURN:	    float -- the rounded value, or -1F if an error has occurred.
  *
- * NOTES:	    none.
+ * NOTES:	    The rounding is carried out by iec_eserd().
  ***/
 float iec_eser(float value, int series, int direction)
 {
-  if (!isnormal(value) || value <= 0)
-    return -1.0F;
-
-  switch (series) {
-  case IEC_E3:
-    return stdvalue(gnp10(value), (float *)&e3,
-		    sizeof(e3) / sizeof(float), direction);
-  case IEC_E6:
-    return stdvalue(gnp10(value), (float *)&e6,
-		    sizeof(e6) / sizeof(float), direction);
-  case IEC_E12:
-    return stdvalue(gnp10(value), (float *)&e12,
-		    sizeof(e12) / sizeof(float), direction);
-  case IEC_E24:
-    return stdvalue(gnp10(value), (float *)&e24,
-		    sizeof(e24) / sizeof(float), direction);
-  case IEC_E48:
-    return stdvalue(gnp10(value), (float *)&e48,
-		    sizeof(e48) / sizeof(float), direction);
-  case IEC_E96:
-    return stdvalue(gnp10(value), (float *)&e96,
-		    sizeof(e96) / sizeof(float), direction);
-  case IEC_E192:
-    return stdvalue(gnp10(value), (float *)&e192,
-		    sizeof(e192) / sizeof(float), direction);
-  default:
-    return -1.0F;
-  }
+  return (float)iec_eserd(value, series, direction);
 }
 
 /*******************************************************************************
@@ -229,23 +328,136 @@ float iec_eser(float value, int series, int direction)
  ***/
 float iec_etol(float value, float tolerance, int direction)
 {
-  if (tolerance < 1.0F) {
-    return iec_eser(value, IEC_E192, direction);
-  } else if (tolerance < 2.0F) {
-    return iec_eser(value, IEC_E96, direction);
-  } else if (tolerance < 5.0F) {
-    return iec_eser(value, IEC_E48, direction);
-  } else if (tolerance < 10.0F) {
-    return iec_eser(value, IEC_E24, direction);
-  } else if (tolerance < 20.0F) {
-    return iec_eser(value, IEC_E12, direction);
-  } else if (tolerance == 20.0F) {
-    return iec_eser(value, IEC_E6, direction);
-  } else if (tolerance > 20.0F) {
-    return iec_eser(value, IEC_E3, direction);
+  return (float)iec_etold(value, tolerance, direction);
+}
+
+/*******************************************************************************
+ * FUNCTION:	    iec_eserd
+ *
+ * DESCRIPTION:	    Round `value' to the nearest value in the IEC E series
+ *		    `series,' or to the next value in direction `direction.'
+ *
+ * ARGUMENTS:	    value: (double) -- the value to round.
+ *		    series: (int) -- the series to use. One of macros defined in
+ *			iec60062.h.
+ *		    direction: (int) -- the direction to round in. One of macros
+ *			defined in iec60062.h.
+ *
+ * RETURN:	    double -- the rounded value, or -1 if an error has occurred.
+ *
+ * NOTES:	    The value is never narrowed to float, so values at the
+ *		    pico and giga scales round into the correct decade.
+ ***/
+double iec_eserd(double value, int series, int direction)
+{
+  size_t size = 0;
+  const double * array = eseries(series, &size);
+  if (array == NULL)
+    return -1.0;
+
+  return stdvalue(value, array, size, direction);
+}
+
+/*******************************************************************************
+ * FUNCTION:	    iec_etold
+ *
+ * DESCRIPTION:	    Round `value' to the nearest value in the IEC E series with
+ *		    tolerance `tolerance,' or to the next value in `direction.'
+ *
+ * ARGUMENTS:	    value: (double) -- the value to round.
+ *		    tolerance: (double) -- the decimal tolerance value to use
+ *			for rounding. Value returned is NOT guaranteed to be
+ *			within the tolerance specified.
+ *		    direction: (int) -- the direction to round. One of macros
+ *			defined in iec60062.h.
+ *
+ * RETURN:	    double -- the rounded value, or -1 if an error has occurred.
+ *
+ * NOTES:	    See iec_etol(). A NaN tolerance, which iec_rtod() uses for
+ *		    values with no tolerance code, is an error.
+ ***/
+double iec_etold(double value, double tolerance, int direction)
+{
+  return iec_eserd(value, etolseries(tolerance), direction);
+}
+
+/*******************************************************************************
+ * FUNCTION:	    iec_eserd_batch
+ *
+ * DESCRIPTION:	    Round each of the `count' values in `values' using the IEC
+ *		    E series `series,' and place the results in `rounded.'
+ *
+ * ARGUMENTS:	    values: (const double *) -- the values to round.
+ *		    rounded: (double *) -- location to place the rounded values.
+ *			May be the same array as `values.'
+ *		    count: (size_t) -- the number of values in each array.
+ *		    series: (int) -- the series to use. One of macros defined in
+ *			iec60062.h.
+ *		    direction: (int) -- the direction to round in. One of macros
+ *			defined in iec60062.h.
+ *
+ * RETURN:	    size_t -- the number of values which were rounded
+ *		    successfully. Values which could not be rounded are set to
+ *		    -1 in `rounded.'
+ *
+ * NOTES:	    The series table is looked up once for the whole batch. If
+ *		    `series' is invalid, `rounded' is left untouched.
+ ***/
+size_t iec_eserd_batch(const double * values, double * rounded, size_t count,
+		       int series, int direction)
+{
+  size_t size = 0, good = 0;
+  const double * array = eseries(series, &size);
+  if (array == NULL || values == NULL || rounded == NULL)
+    return 0;
+
+  for (size_t i = 0; i < count; i++) {
+    rounded[i] = stdvalue(values[i], array, size, direction);
+    if (rounded[i] > 0.0)
+      good++;
+  }
+
+  return good;
+}
+
+/*******************************************************************************
+ * FUNCTION:	    iec_etold_batch
+ *
+ * DESCRIPTION:	    Round each of the `count' values in `values' to the IEC E
+ *		    series selected by the matching entry in `tolerances,' and
+ *		    place the results in `rounded.'
+ *
+ * ARGUMENTS:	    values: (const double *) -- the values to round.
+ *		    tolerances: (const double *) -- the tolerance of each value.
+ *		    rounded: (double *) -- location to place the rounded values.
+ *			May be the same array as `values.'
+ *		    count: (size_t) -- the number of values in each array.
+ *		    direction: (int) -- the direction to round in. One of macros
+ *			defined in iec60062.h.
+ *
+ * RETURN:	    size_t -- the number of values which were rounded
+ *		    successfully. Values which could not be rounded are set to
+ *		    -1 in `rounded.'
+ *
+ * NOTES:	    See iec_etold(). Values with a NaN tolerance are set to -1.
+ ***/
+size_t iec_etold_batch(const double * values, const double * tolerances,
+		       double * rounded, size_t count, int direction)
+{
+  size_t size = 0, good = 0;
+  const double * array = NULL;
+  if (values == NULL || tolerances == NULL || rounded == NULL)
+    return 0;
+
+  for (size_t i = 0; i < count; i++) {
+    array = eseries(etolseries(tolerances[i]), &size);
+    rounded[i] = array == NULL ? -1.0
+      : stdvalue(values[i], array, size, direction);
+    if (rounded[i] > 0.0)
+      good++;
   }
 
-  return -1.0F;
+  return good;
 }
 
 /*******************************************************************************
@@ -258,48 +470,249 @@ float iec_etol(float value, float tolerance, int direction)
  * DESCRIPTION:	    Find the greatest natural power of 10, k, such that
  *		    value mod (10 ^ k) > 0, value mod (10 ^ (k - 1)) == 0
  *
- * ARGUMENTS:	    value: (float) -- the value to round.
+ * ARGUMENTS:	    value: (double) -- the value to round.
  *
- * RETURN:	    float -- the value, or NaN if an error occurs.
+ * RETURN:	    double -- the value, or NaN if an error occurs.
  *
- * NOTES:	    none.
+ * NOTES:	    log10() may round across a decade edge (e.g. for 1e-12 or
+ *		    values just below 1e9), so the result is checked against
+ *		    the scaled value and corrected by one if necessary.
  ***/
-static float gnp10(float value)
+static double gnp10(double value)
 {
-  if (!isnormal(value) || value <= 0.0F)
+  if (!isnormal(value) || value <= 0.0)
     return NAN;
 
-  return floorf(log10f(value));
+  double k = floor(log10(value));
+  double scaled = scale10(value, -(int)k);
+  if (scaled >= 10.0)
+    k += 1.0;
+  else if (scaled < 1.0)
+    k -= 1.0;
+
+  return k;
 }
 
-static float stdvalue(float value, float * array, size_t size, int direction)
+/*******************************************************************************
+ * FUNCTION:	    scale10
+ *
+ * DESCRIPTION:	    Compute value * 10 ^ exponent. For exponents of 22 or less
+ *		    in magnitude, this is done with a single rounding.
+ *
+ * ARGUMENTS:	    value: (double) -- the value to scale.
+ *		    exponent: (int) -- the power of ten to scale by.
+ *
+ * RETURN:	    double -- the scaled value.
+ *
+ * NOTES:	    Negative exponents divide by the exact power of ten rather
+ *		    than multiplying by its (inexact) reciprocal. Powers of ten
+ *		    which are out of the range of a double are applied in two
+ *		    steps, so that e.g. 470 * 10 ^ -310 does not become 0.
+ ***/
+static double scale10(double value, int exponent)
+{
+  const int max = sizeof(p10) / sizeof(double) - 1;
+  if (exponent > DBL_MAX_10_EXP)
+    return scale10(value * p10[max], exponent - max);
+  else if (-exponent > DBL_MAX_10_EXP)
+    return scale10(value / p10[max], exponent + max);
+
+  if (exponent >= 0)
+    return value * (exponent <= max ? p10[exponent] : pow(10, exponent));
+  else
+    return value / (-exponent <= max ? p10[-exponent] : pow(10, -exponent));
+}
+
+/*******************************************************************************
+ * FUNCTION:	    stdvalue
+ *
+ * DESCRIPTION:	    Round `value' to an entry of the series table `array,' in
+ *		    any decade, in direction `direction.'
+ *
+ * ARGUMENTS:	    value: (double) -- the value to round.
+ *		    array: (const double *) -- the series table, in ascending
+ *			order, with every entry in [1, 10).
+ *		    size: (size_t) -- the number of entries in `array.'
+ *		    direction: (int) -- the direction to round in. One of macros
+ *			defined in iec60062.h.
+ *
+ * RETURN:	    double -- the rounded value, or -1 if an error has occurred.
+ *
+ * NOTES:	    Rounding to the nearest value is done on a log scale, which
+ *		    is how the E series are spaced. The scaled value is only
+ *		    used to find the neighbouring entries; the choice between
+ *		    them is made by comparing `value' with the candidates
+ *		    themselves, so that rounding up never returns less than
+ *		    `value,' and rounding down never returns more.
+ ***/
+static double stdvalue(double value, const double * array, size_t size,
+		       int direction)
 {
-  float t = gnp10(value);
-  if (isnan(t))
-    return -1.0F;
-  value /= pow(10, (int)t);
-
-  size_t index = size / 3;
-  if (value < array[index * 2]) {
-    if (value < array[index])
-      index = 0;
+  double t = gnp10(value);
+  if (isnan(t) || array == NULL || size == 0)
+    return -1.0;
+  if (direction != IEC_ROUND_UP && direction != IEC_ROUND_DOWN
+      && direction != IEC_ROUND_NEAR)
+    return -1.0;
+
+  int exponent = (int)t;
+  double scaled = scale10(value, -exponent);
+
+  /* Find the last entry not greater than scaled. Index -1 is the last entry
+   * of the previous decade, and index size the first entry of the next. */
+  long lo = -1, hi = (long)size;
+  while (hi - lo > 1) {
+    long mid = lo + (hi - lo) / 2;
+    if (array[mid] <= scaled)
+      lo = mid;
+    else
+      hi = mid;
+  }
+
+  /* The scaled value may be a rounding away from the true bracket, so check
+   * the candidates against value and step by one entry if needed. */
+  long index;
+  double lower = entry(array, size, lo, exponent);
+  double upper = entry(array, size, hi, exponent);
+  if (lower == value) {
+    index = lo;
+  } else if (upper == value) {
+    index = hi;
+  } else if (direction == IEC_ROUND_UP) {
+    index = lower >= value ? lo : hi;
+    while (entry(array, size, index, exponent) < value)
+      index++;
+  } else if (direction == IEC_ROUND_DOWN) {
+    index = upper <= value ? hi : lo;
+    while (entry(array, size, index, exponent) > value)
+      index--;
   } else {
-    index *= 2;
+    double a = lo < 0 ? array[size - 1] / 10.0 : array[lo];
+    double b = hi < (long)size ? array[hi] : array[0] * 10.0;
+    index = scaled * scaled < a * b ? lo : hi;
+  }
+
+  /* Rounding up from the top of the double range overflows */
+  double result = entry(array, size, index, exponent);
+  return isfinite(result) && result > 0.0 ? result : -1.0;
+}
+
+/*******************************************************************************
+ * FUNCTION:	    entry
+ *
+ * DESCRIPTION:	    Compute the value of entry `index' of the series table
+ *		    `array,' in the decade 10 ^ `exponent.' Indices outside of
+ *		    the table refer to the neighbouring decades.
+ *
+ * ARGUMENTS:	    array: (const double *) -- the series table.
+ *		    size: (long) -- the number of entries in `array.'
+ *		    index: (long) -- the index of the entry.
+ *		    exponent: (int) -- the decade of entry 0.
+ *
+ * RETURN:	    double -- the entry, correctly rounded from its decimal
+ *		    value. May be 0 or inf at the ends of the double range.
+ *
+ * NOTES:	    Table entries have two decimal places, so the entry is
+ *		    built from an integer number of hundredths. Within 10 ^ 22,
+ *		    scale10() rounds only once; beyond it, strtod() is used,
+ *		    which rounds the decimal string correctly.
+ ***/
+static double entry(const double * array, long size, long index,
+		    int exponent)
+{
+  while (index < 0) {
+    index += size;
+    exponent--;
+  }
+  while (index >= size) {
+    index -= size;
+    exponent++;
   }
 
-  float t1 = 0.0F, t2 = 0.0F;
-  /* TODO: Print the static structures to C code */
-  while (index < size) { /* TODO: Incorrect Implementation of the algorithm. */
-    if (array[index] == value)
-      return value;
-    t2 = t1;
-    t1 = array[index] / value;
-    if (t1 < t2)
-      return array[--index] * pow(10, (int)t);
-    index++;
+  long code = lround(array[index] * 100.0);
+  exponent -= 2;
+  if (exponent >= -22 && exponent <= 22)
+    return scale10((double)code, exponent);
+
+  char buffer[32];
+  snprintf(buffer, sizeof(buffer), "%lde%d", code, exponent);
+  return strtod(buffer, NULL);
+}
+
+/*******************************************************************************
+ * FUNCTION:	    eseries
+ *
+ * DESCRIPTION:	    Look up the table for the IEC E series `series.'
+ *
+ * ARGUMENTS:	    series: (int) -- the series. One of macros defined in
+ *			iec60062.h.
+ *		    size: (size_t *) -- location to place the number of entries
+ *			in the table.
+ *
+ * RETURN:	    const double * -- the table, or NULL if `series' is not an
+ *		    E series.
+ *
+ * NOTES:	    none.
+ ***/
+static const double * eseries(int series, size_t * size)
+{
+  switch (series) {
+  case IEC_E3:
+    *size = sizeof(e3) / sizeof(double);
+    return e3;
+  case IEC_E6:
+    *size = sizeof(e6) / sizeof(double);
+    return e6;
+  case IEC_E12:
+    *size = sizeof(e12) / sizeof(double);
+    return e12;
+  case IEC_E24:
+    *size = sizeof(e24) / sizeof(double);
+    return e24;
+  case IEC_E48:
+    *size = sizeof(e48) / sizeof(double);
+    return e48;
+  case IEC_E96:
+    *size = sizeof(e96) / sizeof(double);
+    return e96;
+  case IEC_E192:
+    *size = sizeof(e192) / sizeof(double);
+    return e192;
+  default:
+    return NULL;
+  }
+}
+
+/*******************************************************************************
+ * FUNCTION:	    etolseries
+ *
+ * DESCRIPTION:	    Select the IEC E series for the tolerance `tolerance.'
+ *
+ * ARGUMENTS:	    tolerance: (double) -- the tolerance, in percent.
+ *
+ * RETURN:	    int -- the series, or -1 if `tolerance' is NaN.
+ *
+ * NOTES:	    none.
+ ***/
+static int etolseries(double tolerance)
+{
+  if (tolerance < 1.0) {
+    return IEC_E192;
+  } else if (tolerance < 2.0) {
+    return IEC_E96;
+  } else if (tolerance < 5.0) {
+    return IEC_E48;
+  } else if (tolerance < 10.0) {
+    return IEC_E24;
+  } else if (tolerance < 20.0) {
+    return IEC_E12;
+  } else if (tolerance == 20.0) {
+    return IEC_E6;
+  } else if (tolerance > 20.0) {
+    return IEC_E3;
   }
 
-  return -1.0F; /* Should never get here. */
+  return -1;
 }
 
 /******************************************************************************/
@@ -10,9 +10,15 @@
  *
  * CREATED:	    11/07/2017
  *
- * LAST EDITED:	    11/14/2017
+ * LAST EDITED:	    10/19/2026
  ***/
 
+/*******************************************************************************
+ * INCLUDES
+ ***/
+
+#include <stddef.h>
+
 /*******************************************************************************
  * MACRO DEFINITIONS
  ***/
@@ -23,6 +29,11 @@
 #define IEC_RESISTOR	0x1
 #define IEC_INDUCTOR	0x2
 
+/* Capacitors and inductors share the same "R" notation, so iec_rtof() cannot
+ * tell them apart. This is not a combination of the bits above.
+ */
+#define IEC_CAP_OR_IND	0x4
+
 /* IEC E series for iec_etol() and iec_eser()
  */
 #define IEC_E3		0x004
@@ -63,6 +74,12 @@ extern char * iec_rtostr(float value, float tolerance, int type);
  */
 extern float iec_rtof(char * rvalue, float * tolerance, int * type);
 
+/**
+ * Return the double value of the "R" notation, and place the tolerance in
+ * *tolerance.
+ */
+extern double iec_rtod(const char * rvalue, double * tolerance, int * type);
+
 /**
  * Round `value' using the Renard series.
  */
@@ -78,4 +95,29 @@ extern float iec_eser(float value, int series, int direction);
  */
 extern float iec_etol(float value, float tolerance, int direction);
 
+/**
+ * Round value using E series `series,' in double precision
+ */
+extern double iec_eserd(double value, int series, int direction);
+
+/**
+ * Round value to E series using `tolerance,' in double precision. A NaN
+ * tolerance (unknown) is an error.
+ */
+extern double iec_etold(double value, double tolerance, int direction);
+
+/**
+ * Round `count' values using E series `series.' Returns the number of values
+ * rounded successfully.
+ */
+extern size_t iec_eserd_batch(const double * values, double * rounded,
+			      size_t count, int series, int direction);
+
+/**
+ * Round `count' values to E series using the matching entry in `tolerances.'
+ * Returns the number of values rounded successfully.
+ */
+extern size_t iec_etold_batch(const double * values, const double * tolerances,
+			      double * rounded, size_t count, int direction);
+
 /******************************************************************************/
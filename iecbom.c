@@ -0,0 +1,342 @@
+/*******************************************************************************
+ * NAME:	    iecbom.c
+ *
+ * AUTHOR:	    Ethan D. Twardy
+ *
+ * DESCRIPTION:	    This file contains functions to read and write a columnar
+ *		    binary format for component databases. The reader maps the
+ *		    file into memory, so that the columns can be handed to the
+ *		    batch rounding functions without copying.
+ *
+ * CREATED:	    10/19/2026
+ *
+ * LAST EDITED:	    10/19/2026
+ ***/
+
+/*******************************************************************************
+ * INCLUDES
+ ***/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <ctype.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#include "iec60062.h"
+#include "iecbom.h"
+
+/*******************************************************************************
+ * STATIC FUNCTION PROTOTYPES
+ ***/
+
+static uint64_t align(uint64_t offset);
+static int column(const struct iec_bom_header * header, uint64_t offset,
+		  size_t size, size_t length);
+static int writeout(const char * binary, size_t count, const double * value,
+		    const double * tolerance, const int32_t * type);
+
+/*******************************************************************************
+ * API FUNCTIONS
+ ***/
+
+/*******************************************************************************
+ * FUNCTION:	    iec_bom_open
+ *
+ * DESCRIPTION:	    Map the BOM file at `path' into memory, and set up pointers
+ *		    to each of its columns.
+ *
+ * ARGUMENTS:	    path: (const char *) -- the path of the BOM file.
+ *		    mode: (int) -- IEC_BOM_PRIVATE or IEC_BOM_SHARED. See
+ *			iecbom.h.
+ *
+ * RETURN:	    struct iec_bom * -- the mapped BOM, or NULL if an error
+ *		    occurred, in which case errno is set.
+ *
+ * NOTES:	    The returned struct must be released with iec_bom_close().
+ ***/
+struct iec_bom * iec_bom_open(const char * path, int mode)
+{
+  if (path == NULL || (mode != IEC_BOM_PRIVATE && mode != IEC_BOM_SHARED)) {
+    errno = EINVAL;
+    return NULL;
+  }
+
+  int fd = open(path, mode == IEC_BOM_SHARED ? O_RDWR : O_RDONLY);
+  if (fd == -1)
+    return NULL;
+
+  struct stat st;
+  if (fstat(fd, &st) == -1) {
+    close(fd);
+    return NULL;
+  }
+  if ((size_t)st.st_size < sizeof(struct iec_bom_header)) {
+    close(fd);
+    errno = EINVAL;
+    return NULL;
+  }
+
+  size_t length = (size_t)st.st_size;
+  void * map = mmap(NULL, length, PROT_READ | PROT_WRITE,
+		    mode == IEC_BOM_SHARED ? MAP_SHARED : MAP_PRIVATE, fd, 0);
+  close(fd);
+  if (map == MAP_FAILED)
+    return NULL;
+
+  const struct iec_bom_header * header = map;
+  if (memcmp(header->magic, IEC_BOM_MAGIC, sizeof(header->magic))
+      || header->version != IEC_BOM_VERSION
+      || column(header, header->value, sizeof(double), length)
+      || column(header, header->tolerance, sizeof(double), length)
+      || column(header, header->type, sizeof(int32_t), length)
+      || column(header, header->rounded, sizeof(double), length)) {
+    munmap(map, length);
+    errno = EINVAL;
+    return NULL;
+  }
+
+  struct iec_bom * bom = malloc(sizeof(struct iec_bom));
+  if (bom == NULL) {
+    munmap(map, length);
+    return NULL;
+  }
+
+  char * base = map;
+  bom->count = (size_t)header->count;
+  bom->value = (const double *)(base + header->value);
+  bom->tolerance = (const double *)(base + header->tolerance);
+  bom->type = (const int32_t *)(base + header->type);
+  bom->rounded = (double *)(base + header->rounded);
+  bom->map = map;
+  bom->length = length;
+
+  /* The file is expected to be rounded many times over */
+  madvise(map, length, MADV_WILLNEED);
+  return bom;
+}
+
+/*******************************************************************************
+ * FUNCTION:	    iec_bom_close
+ *
+ * DESCRIPTION:	    Unmap the BOM file and free `bom.'
+ *
+ * ARGUMENTS:	    bom: (struct iec_bom *) -- the BOM returned by
+ *			iec_bom_open(). May be NULL.
+ *
+ * RETURN:	    void.
+ *
+ * NOTES:	    With IEC_BOM_SHARED, the rounded column is written back to
+ *		    the file by the kernel; use msync() first if it must be on
+ *		    disk before this returns.
+ ***/
+void iec_bom_close(struct iec_bom * bom)
+{
+  if (bom == NULL)
+    return;
+
+  munmap(bom->map, bom->length);
+  free(bom);
+}
+
+/*******************************************************************************
+ * FUNCTION:	    iec_bom_convert
+ *
+ * DESCRIPTION:	    Convert the text file at `text,' which contains one
+ *		    component in "R" notation per line (see iec_rtod()), to a
+ *		    BOM file at `binary.'
+ *
+ * ARGUMENTS:	    text: (const char *) -- the path of the text file.
+ *		    binary: (const char *) -- the path of the BOM file to
+ *			create.
+ *		    line: (size_t *) -- location to place the number of the
+ *			line which could not be parsed, if any. May be NULL.
+ *
+ * RETURN:	    long -- the number of components written, or -1 if an
+ *		    error occurred, in which case errno is set.
+ *
+ * NOTES:	    Only the first word on each line is parsed. Blank lines and
+ *		    lines beginning with `#' are skipped.
+ ***/
+long iec_bom_convert(const char * text, const char * binary, size_t * line)
+{
+  FILE * in = fopen(text, "r");
+  if (in == NULL)
+    return -1;
+
+  size_t count = 0, size = 0, lineno = 0, n = 0;
+  double * value = NULL, * tolerance = NULL;
+  int32_t * type = NULL;
+  char * buffer = NULL;
+  long ret = -1;
+  while (getline(&buffer, &n, in) != -1) {
+    lineno++;
+    char * word = buffer;
+    while (isspace((unsigned char)*word))
+      word++;
+    if (*word == '\0' || *word == '#')
+      continue;
+    char * end = word;
+    while (*end != '\0' && !isspace((unsigned char)*end))
+      end++;
+    *end = '\0';
+
+    if (count == size) {
+      size = size ? size * 2 : 1024;
+      double * v = realloc(value, size * sizeof(double));
+      if (v != NULL)
+	value = v;
+      double * t = realloc(tolerance, size * sizeof(double));
+      if (t != NULL)
+	tolerance = t;
+      int32_t * y = realloc(type, size * sizeof(int32_t));
+      if (y != NULL)
+	type = y;
+      if (v == NULL || t == NULL || y == NULL)
+	goto out;
+    }
+
+    int kind = 0;
+    value[count] = iec_rtod(word, &tolerance[count], &kind);
+    if (value[count] < 0.0) {
+      if (line != NULL)
+	*line = lineno;
+      errno = EINVAL;
+      goto out;
+    }
+    type[count++] = kind;
+  }
+  if (ferror(in))
+    goto out;
+
+  if (writeout(binary, count, value, tolerance, type) == 0)
+    ret = (long)count;
+
+ out:
+  free(buffer);
+  free(value);
+  free(tolerance);
+  free(type);
+  fclose(in);
+  return ret;
+}
+
+/*******************************************************************************
+ * STATIC FUNCTIONS
+ ***/
+
+/*******************************************************************************
+ * FUNCTION:	    align
+ *
+ * DESCRIPTION:	    Round `offset' up to the next multiple of IEC_BOM_ALIGN.
+ *
+ * ARGUMENTS:	    offset: (uint64_t) -- the offset to align.
+ *
+ * RETURN:	    uint64_t -- the aligned offset.
+ *
+ * NOTES:	    none.
+ ***/
+static uint64_t align(uint64_t offset)
+{
+  return (offset + IEC_BOM_ALIGN - 1) / IEC_BOM_ALIGN * IEC_BOM_ALIGN;
+}
+
+/*******************************************************************************
+ * FUNCTION:	    column
+ *
+ * DESCRIPTION:	    Check that a column of `header->count' elements of `size'
+ *		    bytes, starting at `offset,' lies within the file.
+ *
+ * ARGUMENTS:	    header: (const struct iec_bom_header *) -- the header.
+ *		    offset: (uint64_t) -- the offset of the column.
+ *		    size: (size_t) -- the size of each element.
+ *		    length: (size_t) -- the length of the file.
+ *
+ * RETURN:	    int -- 0 if the column is valid, -1 otherwise.
+ *
+ * NOTES:	    none.
+ ***/
+static int column(const struct iec_bom_header * header, uint64_t offset,
+		  size_t size, size_t length)
+{
+  if (offset % size != 0 || offset < sizeof(struct iec_bom_header)
+      || offset > length || header->count > (length - offset) / size)
+    return -1;
+  return 0;
+}
+
+/*******************************************************************************
+ * FUNCTION:	    writeout
+ *
+ * DESCRIPTION:	    Write the header and columns of a BOM file to `binary.'
+ *
+ * ARGUMENTS:	    binary: (const char *) -- the path of the BOM file.
+ *		    count: (size_t) -- the number of components.
+ *		    value: (const double *) -- the value column.
+ *		    tolerance: (const double *) -- the tolerance column.
+ *		    type: (const int32_t *) -- the type column.
+ *
+ * RETURN:	    int -- 0 on success, -1 if an error occurred.
+ *
+ * NOTES:	    The rounded column is filled with zeroes.
+ ***/
+static int writeout(const char * binary, size_t count, const double * value,
+		    const double * tolerance, const int32_t * type)
+{
+  static const char zeroes[IEC_BOM_ALIGN] = { 0 };
+  struct iec_bom_header header;
+  memset(&header, 0, sizeof(header));
+  memcpy(header.magic, IEC_BOM_MAGIC, sizeof(header.magic));
+  header.version = IEC_BOM_VERSION;
+  header.count = count;
+  header.value = align(sizeof(header));
+  header.tolerance = align(header.value + count * sizeof(double));
+  header.type = align(header.tolerance + count * sizeof(double));
+  header.rounded = align(header.type + count * sizeof(int32_t));
+
+  FILE * out = fopen(binary, "wb");
+  if (out == NULL)
+    return -1;
+
+  const struct {
+    const void * data;
+    uint64_t offset;
+    size_t size;
+  } columns[] = {
+    { value, header.value, sizeof(double) },
+    { tolerance, header.tolerance, sizeof(double) },
+    { type, header.type, sizeof(int32_t) },
+    { NULL, header.rounded, sizeof(double) }
+  };
+
+  uint64_t offset = sizeof(header);
+  int ret = fwrite(&header, sizeof(header), 1, out) == 1 ? 0 : -1;
+  for (size_t i = 0; ret == 0 && i < sizeof(columns) / sizeof(columns[0]);
+       i++) {
+    if (fwrite(zeroes, 1, columns[i].offset - offset, out)
+	!= columns[i].offset - offset)
+      ret = -1;
+    offset = columns[i].offset;
+    if (columns[i].data != NULL
+	&& fwrite(columns[i].data, columns[i].size, count, out) != count)
+      ret = -1;
+    size_t left = columns[i].data == NULL ? count * columns[i].size : 0;
+    while (ret == 0 && left > 0) {
+      size_t chunk = left < sizeof(zeroes) ? left : sizeof(zeroes);
+      if (fwrite(zeroes, 1, chunk, out) != chunk)
+	ret = -1;
+      left -= chunk;
+    }
+    offset += count * columns[i].size;
+  }
+
+  if (fclose(out) != 0)
+    ret = -1;
+  return ret;
+}
+
+/******************************************************************************/
@@ -0,0 +1,99 @@
+/*******************************************************************************
+ * NAME:	    iecbom.h
+ *
+ * AUTHOR:	    Ethan D. Twardy
+ *
+ * DESCRIPTION:	    This file contains the public interface for the C source in
+ *		    iecbom.c. These functions read and write a columnar binary
+ *		    format for component databases (BOMs), so that the same
+ *		    database can be rounded many times without parsing it
+ *		    again.
+ *
+ * CREATED:	    10/19/2026
+ *
+ * LAST EDITED:	    10/19/2026
+ ***/
+
+#ifndef __IECBOM_H__
+#define __IECBOM_H__
+
+/*******************************************************************************
+ * INCLUDES
+ ***/
+
+#include <stddef.h>
+#include <stdint.h>
+
+/*******************************************************************************
+ * MACRO DEFINITIONS
+ ***/
+
+#define IEC_BOM_MAGIC	"IECBOM\0\0"
+#define IEC_BOM_VERSION	1
+
+/* Columns are aligned to this many bytes from the start of the file */
+#define IEC_BOM_ALIGN	64
+
+/* Modes for iec_bom_open(). With IEC_BOM_PRIVATE, writes to the `rounded'
+ * column stay in memory. With IEC_BOM_SHARED, they are written back to the
+ * file.
+ */
+#define IEC_BOM_PRIVATE	0x0
+#define IEC_BOM_SHARED	0x1
+
+/*******************************************************************************
+ * TYPE DEFINITIONS
+ ***/
+
+/* The file begins with this header. All fields are in host byte order. Each
+ * column is an array of `count' elements, starting at the given byte offset.
+ */
+struct iec_bom_header {
+  char magic[8];
+  uint32_t version;
+  uint32_t reserved;
+  uint64_t count;
+  uint64_t value;	/* double: component value */
+  uint64_t tolerance;	/* double: tolerance in percent, NaN if unknown */
+  uint64_t type;	/* int32_t: IEC_RESISTOR, IEC_CAP_OR_IND, etc. */
+  uint64_t rounded;	/* double: rounded value, 0 until rounded */
+};
+
+/* A mapped BOM file. The column pointers point into the mapping, and may be
+ * passed straight to the batch functions in iec60062.h.
+ */
+struct iec_bom {
+  size_t count;
+  const double * value;
+  const double * tolerance;
+  const int32_t * type;
+  double * rounded;
+
+  void * map;
+  size_t length;
+};
+
+/*******************************************************************************
+ * API FUNCTION PROTOTYPES
+ ***/
+
+/**
+ * Map the BOM file at `path.' The returned struct must be released with
+ * iec_bom_close().
+ */
+extern struct iec_bom * iec_bom_open(const char * path, int mode);
+
+/**
+ * Unmap the BOM file and free `bom.'
+ */
+extern void iec_bom_close(struct iec_bom * bom);
+
+/**
+ * Convert the "R" notation text file at `text' to a BOM file at `binary.'
+ */
+extern long iec_bom_convert(const char * text, const char * binary,
+			    size_t * line);
+
+#endif /* __IECBOM_H__ */
+
+/******************************************************************************/
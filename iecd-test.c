@@ -0,0 +1,282 @@
+/*******************************************************************************
+ * NAME:	    iecd-test.c
+ *
+ * AUTHOR:	    Ethan D. Twardy
+ *
+ * DESCRIPTION:	    A smoke test for the rounding daemon. Starts the daemon,
+ *		    rounds values from several concurrent clients, and compares
+ *		    the results with iec_eserd_batch(). Also checks that a
+ *		    client which shuts down its end of the connection still
+ *		    receives its responses. Exits with a non-zero status if any
+ *		    check fails.
+ *
+ * CREATED:	    10/19/2026
+ *
+ * LAST EDITED:	    10/19/2026
+ ***/
+
+/*******************************************************************************
+ * INCLUDES
+ ***/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <signal.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/socket.h>
+#include <sys/wait.h>
+
+#include "iec60062.h"
+#include "iecd.h"
+#include "error.h"
+
+/*******************************************************************************
+ * MACRO DEFINITIONS
+ ***/
+
+#define CLIENTS	8
+#define VALUES	100000
+
+/*******************************************************************************
+ * STATIC FUNCTION PROTOTYPES
+ ***/
+
+static int client(const char * path, int number);
+static int halfclose(const char * path);
+static int oversized(const char * path);
+static int second(const char * iecd, const char * path);
+
+/*******************************************************************************
+ * MAIN
+ ***/
+
+int main(int argc, char * argv[]) {
+
+  StopIf(argc != 2, 1, "Usage: %s <path to iecd>\n", argv[0]);
+
+  char path[64];
+  snprintf(path, sizeof(path), "/tmp/iecd-test-%d.sock", (int)getpid());
+
+  pid_t daemon = fork();
+  StopIf(daemon == -1, 1, ERROR_PRINT"fork failed\n");
+  if (daemon == 0) {
+    execl(argv[1], argv[1], "-s", path, "-i", "60", (char *)NULL);
+    perror(argv[1]);
+    _exit(1);
+  }
+
+  /* Wait for the daemon to start listening */
+  int fd = -1;
+  struct timespec wait = { 0, 10000000 };
+  for (int i = 0; i < 200 && fd == -1; i++) {
+    fd = iecd_connect(path);
+    if (fd == -1)
+      nanosleep(&wait, NULL);
+  }
+  StopIf(fd == -1, 1, ERROR_PRINT"could not connect to %s\n", path);
+  close(fd);
+
+  pid_t pids[CLIENTS];
+  for (int i = 0; i < CLIENTS; i++) {
+    pids[i] = fork();
+    if (pids[i] == 0) {
+      int ret = client(path, i);
+      fflush(stdout);
+      _exit(ret);
+    }
+  }
+
+  int failures = 0, status;
+  for (int i = 0; i < CLIENTS; i++) {
+    if (waitpid(pids[i], &status, 0) == -1 || !WIFEXITED(status)
+	|| WEXITSTATUS(status) != 0)
+      failures++;
+  }
+  failures += halfclose(path);
+  failures += oversized(path);
+  failures += second(argv[1], path);
+
+  kill(daemon, SIGTERM);
+  if (waitpid(daemon, &status, 0) == -1 || !WIFEXITED(status)
+      || WEXITSTATUS(status) != 0) {
+    printf("FAIL daemon did not exit cleanly\n");
+    failures++;
+  }
+
+  printf("%d failures\n", failures);
+  return failures != 0;
+}
+
+/*******************************************************************************
+ * STATIC FUNCTIONS
+ ***/
+
+/*******************************************************************************
+ * FUNCTION:	    client
+ *
+ * DESCRIPTION:	    Round VALUES values, spread across the pico to giga range,
+ *		    through the daemon and compare them with iec_eserd_batch().
+ *
+ * ARGUMENTS:	    path: (const char *) -- the daemon's socket.
+ *		    number: (int) -- the client number, which selects the
+ *			series and direction.
+ *
+ * RETURN:	    int -- 0 if every value matched, 1 otherwise.
+ *
+ * NOTES:	    none.
+ ***/
+static int client(const char * path, int number)
+{
+  const int series[] = { IEC_E6, IEC_E12, IEC_E24, IEC_E96 };
+  const int directions[] = { IEC_ROUND_NEAR, IEC_ROUND_UP };
+  int s = series[number % 4], d = directions[(number / 4) % 2];
+
+  double * values = malloc(VALUES * sizeof(double));
+  double * rounded = malloc(VALUES * sizeof(double));
+  double * expected = malloc(VALUES * sizeof(double));
+  if (values == NULL || rounded == NULL || expected == NULL)
+    return 1;
+  for (int i = 0; i < VALUES; i++)
+    values[i] = 1e-12 * pow(10.0, 21.0 * i / VALUES) * (1.0 + 0.001 * number);
+  iec_eserd_batch(values, expected, VALUES, s, d);
+
+  struct iecd_stats stats;
+  memset(&stats, 0, sizeof(stats));
+  int fd = iecd_connect(path);
+  if (fd == -1 || iecd_round(fd, values, rounded, VALUES, s, d, &stats)) {
+    printf("FAIL client %d: %s\n", number, strerror(errno));
+    return 1;
+  }
+  close(fd);
+
+  int bad = 0;
+  for (int i = 0; i < VALUES; i++)
+    bad += rounded[i] != expected[i];
+  printf("client %d: %llu requests, round trip mean %.1f us, max %.1f us, "
+	 "daemon mean %.1f us, %d mismatches\n", number,
+	 (unsigned long long)stats.requests,
+	 stats.latency / 1e3 / stats.requests, stats.maxlatency / 1e3,
+	 stats.daemon / 1e3 / stats.requests, bad);
+  return bad != 0;
+}
+
+/*******************************************************************************
+ * FUNCTION:	    halfclose
+ *
+ * DESCRIPTION:	    Submit several requests, shut down the writing end of the
+ *		    connection, and check that every response still arrives.
+ *
+ * ARGUMENTS:	    path: (const char *) -- the daemon's socket.
+ *
+ * RETURN:	    int -- the number of failures.
+ *
+ * NOTES:	    none.
+ ***/
+static int halfclose(const char * path)
+{
+  const double values[] = { 4.4, 4.7e-12, 999999999.9 };
+  double rounded[3];
+  struct iecd_header header;
+  int fd = iecd_connect(path), failures = 0;
+  if (fd == -1)
+    return 1;
+
+  for (uint32_t id = 0; id < 3; id++) {
+    if (iecd_submit(fd, id, values, 3, IEC_E12, IEC_ROUND_UP))
+      failures++;
+  }
+  shutdown(fd, SHUT_WR);
+
+  for (uint32_t id = 0; id < 3; id++) {
+    if (iecd_receive(fd, &header, rounded, 3) || header.id != id
+	|| header.count != 3 || rounded[0] != 4.7 || rounded[1] != 4.7e-12
+	|| rounded[2] != 1e9) {
+      printf("FAIL half-closed response %u\n", id);
+      failures++;
+    }
+  }
+
+  /* The daemon closes the connection once the responses are sent */
+  if (iecd_receive(fd, &header, rounded, 3) == 0) {
+    printf("FAIL half-closed connection left open\n");
+    failures++;
+  }
+  close(fd);
+  return failures;
+}
+
+/*******************************************************************************
+ * FUNCTION:	    oversized
+ *
+ * DESCRIPTION:	    Check that the daemon drops a client which sends a request
+ *		    larger than IECD_MAX_COUNT.
+ *
+ * ARGUMENTS:	    path: (const char *) -- the daemon's socket.
+ *
+ * RETURN:	    int -- the number of failures.
+ *
+ * NOTES:	    none.
+ ***/
+static int oversized(const char * path)
+{
+  struct iecd_header header;
+  memset(&header, 0, sizeof(header));
+  header.count = IECD_MAX_COUNT + 1;
+  header.series = IEC_E12;
+  header.direction = IEC_ROUND_NEAR;
+
+  int fd = iecd_connect(path), failures = 0;
+  if (fd == -1)
+    return 1;
+  if (write(fd, &header, sizeof(header)) != sizeof(header)
+      || iecd_receive(fd, &header, NULL, 0) == 0) {
+    printf("FAIL oversized request was not rejected\n");
+    failures++;
+  }
+  close(fd);
+  return failures;
+}
+
+/*******************************************************************************
+ * FUNCTION:	    second
+ *
+ * DESCRIPTION:	    Check that a second daemon refuses to take the socket of a
+ *		    running one, and that the first is still reachable.
+ *
+ * ARGUMENTS:	    iecd: (const char *) -- the path of the daemon.
+ *		    path: (const char *) -- the running daemon's socket.
+ *
+ * RETURN:	    int -- the number of failures.
+ *
+ * NOTES:	    none.
+ ***/
+static int second(const char * iecd, const char * path)
+{
+  int status, failures = 0;
+  pid_t pid = fork();
+  if (pid == 0) {
+    dup2(open("/dev/null", O_WRONLY), 2); /* The refusal is expected */
+    execl(iecd, iecd, "-s", path, (char *)NULL);
+    _exit(0);
+  }
+  if (pid == -1 || waitpid(pid, &status, 0) == -1 || !WIFEXITED(status)
+      || WEXITSTATUS(status) == 0) {
+    printf("FAIL second daemon took a live socket\n");
+    failures++;
+  }
+
+  int fd = iecd_connect(path);
+  if (fd == -1) {
+    printf("FAIL running daemon unreachable after second start\n");
+    return failures + 1;
+  }
+  close(fd);
+  return failures;
+}
+
+/******************************************************************************/
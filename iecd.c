@@ -0,0 +1,667 @@
+/*******************************************************************************
+ * NAME:	    iecd.c
+ *
+ * AUTHOR:	    Ethan D. Twardy
+ *
+ * DESCRIPTION:	    The rounding daemon. Clients connect over a Unix domain
+ *		    socket and send requests, as described in iecd.h. Each time
+ *		    the daemon wakes, it collects every complete request from
+ *		    every client, sorts them by series and direction, and rounds
+ *		    each group with a single call to iec_eserd_batch(). All
+ *		    memory is allocated at startup.
+ *
+ * CREATED:	    10/19/2026
+ *
+ * LAST EDITED:	    10/19/2026
+ ***/
+
+/*******************************************************************************
+ * INCLUDES
+ ***/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <signal.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+
+#include "iec60062.h"
+#include "iecd.h"
+#include "error.h"
+
+/*******************************************************************************
+ * MACRO DEFINITIONS
+ ***/
+
+#define MAX_CLIENTS	64
+
+/* Each client's input and output buffers hold two of the largest messages, so
+ * that one can be read while another is waiting to be rounded.
+ */
+#define MESSAGE_MAX	(sizeof(struct iecd_header)			\
+			 + IECD_MAX_COUNT * sizeof(double))
+#define BUFFER_SIZE	(2 * MESSAGE_MAX)
+
+/* The most requests and values rounded together each time the daemon wakes.
+ * Whatever does not fit waits for the next round.
+ */
+#define MAX_JOBS	(MAX_CLIENTS * 4)
+#define MAX_VALUES	(MAX_CLIENTS * 2 * IECD_MAX_COUNT)
+
+/* The most complete requests an input buffer can hold */
+#define MAX_PENDING	(BUFFER_SIZE / sizeof(struct iecd_header))
+
+/*******************************************************************************
+ * TYPE DEFINITIONS
+ ***/
+
+struct client {
+  int fd;
+  int closed;			/* The client has shut down its end */
+  size_t inlen;
+  size_t scanned;		/* End of the last complete request in `in' */
+  size_t narrivals;
+  uint64_t * arrivals;		/* Arrival time of each complete request */
+  size_t outpos, outlen;
+  unsigned char * in;
+  unsigned char * out;
+};
+
+struct job {
+  struct client * client;
+  struct iecd_header header;
+  size_t position;		/* Offset of the values in client->in */
+  size_t offset;		/* Offset of the values in the batch */
+  size_t index;			/* Position among the client's requests */
+  uint64_t stamp;
+};
+
+struct stats {
+  uint64_t requests;
+  uint64_t values;
+  uint64_t batches;
+  uint64_t latency;
+  uint64_t maxlatency;
+};
+
+/*******************************************************************************
+ * STATIC VARIABLES
+ ***/
+
+static volatile sig_atomic_t done = 0;
+
+static struct client clients[MAX_CLIENTS];
+static struct job jobs[MAX_JOBS];
+static struct job * order[MAX_JOBS];
+static double * batchin;
+static double * batchout;
+
+static struct stats total, interval;
+
+/*******************************************************************************
+ * STATIC FUNCTION PROTOTYPES
+ ***/
+
+static void stop(int signum);
+static int listener(const char * path);
+static void accept_clients(int fd);
+static void drop(struct client * client);
+static void fill(struct client * client, uint64_t stamp);
+static void scan(struct client * client, uint64_t stamp);
+static void flush(struct client * client);
+static int round_batch(void);
+static int compare(const void * a, const void * b);
+static void report(const struct stats * stats, uint64_t elapsed,
+		   const char * label);
+static uint64_t now(void);
+
+/*******************************************************************************
+ * MAIN
+ ***/
+
+int main(int argc, char * argv[]) {
+
+  const char * path = IECD_SOCKET;
+  int period = 10, opt;
+  while ((opt = getopt(argc, argv, "s:i:")) != -1) {
+    switch (opt) {
+    case 's':
+      path = optarg;
+      break;
+    case 'i':
+      period = atoi(optarg);
+      break;
+    default:
+      StopIf(1, 1, "Usage: %s [-s socket] [-i report interval (s)]\n",
+	     argv[0]);
+    }
+  }
+  StopIf(period <= 0, 1, ERROR_PRINT"report interval must be positive\n");
+
+  /* Allocate everything up front */
+  batchin = calloc(MAX_VALUES, sizeof(double));
+  batchout = calloc(MAX_VALUES, sizeof(double));
+  StopIf((batchin == NULL || batchout == NULL), 1,
+	 ERROR_PRINT"out of memory\n");
+  for (int i = 0; i < MAX_CLIENTS; i++) {
+    clients[i].fd = -1;
+    clients[i].in = malloc(BUFFER_SIZE);
+    clients[i].out = malloc(BUFFER_SIZE);
+    clients[i].arrivals = calloc(MAX_PENDING, sizeof(uint64_t));
+    StopIf((clients[i].in == NULL || clients[i].out == NULL
+	    || clients[i].arrivals == NULL), 1,
+	   ERROR_PRINT"out of memory\n");
+  }
+
+  struct sigaction sa;
+  memset(&sa, 0, sizeof(sa));
+  sa.sa_handler = stop;
+  sigaction(SIGINT, &sa, NULL);
+  sigaction(SIGTERM, &sa, NULL);
+  signal(SIGPIPE, SIG_IGN);
+
+  int fd = listener(path);
+  StopIf(fd == -1, 1, ERROR_PRINT"%s: %s\n", path, strerror(errno));
+
+  struct pollfd fds[MAX_CLIENTS + 1];
+  struct client * polled[MAX_CLIENTS + 1];
+  uint64_t start = now(), last = start;
+  int backlog = 0;
+  while (!done) {
+    nfds_t nfds = 0;
+    fds[nfds].fd = fd;
+    fds[nfds].events = POLLIN;
+    polled[nfds++] = NULL;
+    for (int i = 0; i < MAX_CLIENTS; i++) {
+      if (clients[i].fd == -1)
+	continue;
+      fds[nfds].fd = clients[i].fd;
+      fds[nfds].events = (!clients[i].closed && clients[i].inlen < BUFFER_SIZE
+			  ? POLLIN : 0)
+	| (clients[i].outlen > clients[i].outpos ? POLLOUT : 0);
+      polled[nfds++] = &clients[i];
+    }
+
+    uint64_t next = last + (uint64_t)period * 1000000000ULL, t = now();
+    int timeout = backlog ? 0 : next > t ? (int)((next - t) / 1000000) + 1 : 0;
+    if (poll(fds, nfds, timeout) == -1) {
+      StopIf(errno != EINTR, 1, ERROR_PRINT"poll: %s\n", strerror(errno));
+      continue;
+    }
+
+    t = now();
+    for (nfds_t i = 1; i < nfds; i++) {
+      if (fds[i].revents & (POLLIN | POLLHUP | POLLERR))
+	fill(polled[i], t);
+      if (polled[i]->fd != -1 && (fds[i].revents & POLLOUT))
+	flush(polled[i]);
+    }
+    if (fds[0].revents & POLLIN)
+      accept_clients(fd);
+
+    backlog = round_batch();
+    for (int i = 0; i < MAX_CLIENTS; i++) {
+      if (clients[i].fd != -1 && clients[i].outlen > clients[i].outpos)
+	flush(&clients[i]);
+
+      /* Close half-closed clients once every response has been sent */
+      if (clients[i].fd != -1 && clients[i].closed
+	  && clients[i].narrivals == 0
+	  && clients[i].outlen == clients[i].outpos)
+	drop(&clients[i]);
+    }
+
+    t = now();
+    if (t >= next) {
+      if (interval.requests > 0)
+	report(&interval, t - last, "last interval");
+      memset(&interval, 0, sizeof(interval));
+      last = t;
+    }
+  }
+
+  report(&total, now() - start, "total");
+  close(fd);
+  unlink(path);
+  return 0;
+}
+
+/*******************************************************************************
+ * STATIC FUNCTIONS
+ ***/
+
+/*******************************************************************************
+ * FUNCTION:	    stop
+ *
+ * DESCRIPTION:	    Signal handler which asks the main loop to exit.
+ *
+ * ARGUMENTS:	    signum: (int) -- the signal received.
+ *
+ * RETURN:	    void.
+ *
+ * NOTES:	    none.
+ ***/
+static void stop(int signum)
+{
+  done = 1;
+}
+
+/*******************************************************************************
+ * FUNCTION:	    listener
+ *
+ * DESCRIPTION:	    Create a non-blocking Unix domain socket listening at
+ *		    `path.' A stale socket at `path' is removed first.
+ *
+ * ARGUMENTS:	    path: (const char *) -- the path of the socket.
+ *
+ * RETURN:	    int -- the socket, or -1 if an error occurred. errno is
+ *		    EADDRINUSE if another daemon is listening at `path.'
+ *
+ * NOTES:	    A socket is only stale if connecting to it is refused.
+ *		    Anything at `path' which is not a socket is left alone, and
+ *		    bind() fails. The socket is created accessible to the
+ *		    owner only, since the default path is in /tmp.
+ ***/
+static int listener(const char * path)
+{
+  struct sockaddr_un addr;
+  if (strlen(path) >= sizeof(addr.sun_path)) {
+    errno = ENAMETOOLONG;
+    return -1;
+  }
+
+  memset(&addr, 0, sizeof(addr));
+  addr.sun_family = AF_UNIX;
+  strcpy(addr.sun_path, path);
+
+  int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+  if (fd == -1)
+    return -1;
+
+  /* Don't take the path from a daemon which is still running */
+  struct stat st;
+  if (lstat(path, &st) == 0 && S_ISSOCK(st.st_mode)) {
+    if (connect(fd, (struct sockaddr *)&addr, sizeof(addr)) == 0) {
+      close(fd);
+      errno = EADDRINUSE;
+      return -1;
+    }
+    if (errno == ECONNREFUSED)
+      unlink(path);
+    close(fd);
+    fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (fd == -1)
+      return -1;
+  }
+
+  fcntl(fd, F_SETFL, fcntl(fd, F_GETFL) | O_NONBLOCK);
+  mode_t mask = umask(077);
+  int bound = bind(fd, (struct sockaddr *)&addr, sizeof(addr));
+  umask(mask);
+  if (bound == -1 || listen(fd, MAX_CLIENTS) == -1) {
+    int error = errno;
+    close(fd);
+    errno = error;
+    return -1;
+  }
+
+  return fd;
+}
+
+/*******************************************************************************
+ * FUNCTION:	    accept_clients
+ *
+ * DESCRIPTION:	    Accept pending connections into free client slots.
+ *		    Connections beyond MAX_CLIENTS are closed.
+ *
+ * ARGUMENTS:	    fd: (int) -- the listening socket.
+ *
+ * RETURN:	    void.
+ *
+ * NOTES:	    none.
+ ***/
+static void accept_clients(int fd)
+{
+  int conn;
+  while ((conn = accept(fd, NULL, NULL)) != -1) {
+    fcntl(conn, F_SETFL, fcntl(conn, F_GETFL) | O_NONBLOCK);
+    int i = 0;
+    while (i < MAX_CLIENTS && clients[i].fd != -1)
+      i++;
+    if (i == MAX_CLIENTS) {
+      close(conn);
+      continue;
+    }
+
+    clients[i].fd = conn;
+    clients[i].closed = 0;
+    clients[i].inlen = clients[i].scanned = clients[i].narrivals = 0;
+    clients[i].outpos = clients[i].outlen = 0;
+  }
+}
+
+/*******************************************************************************
+ * FUNCTION:	    drop
+ *
+ * DESCRIPTION:	    Close the connection to `client,' and free its slot.
+ *
+ * ARGUMENTS:	    client: (struct client *) -- the client.
+ *
+ * RETURN:	    void.
+ *
+ * NOTES:	    none.
+ ***/
+static void drop(struct client * client)
+{
+  close(client->fd);
+  client->fd = -1;
+}
+
+/*******************************************************************************
+ * FUNCTION:	    fill
+ *
+ * DESCRIPTION:	    Read as much as will fit into the input buffer of `client.'
+ *
+ * ARGUMENTS:	    client: (struct client *) -- the client.
+ *		    stamp: (uint64_t) -- the current time.
+ *
+ * RETURN:	    void.
+ *
+ * NOTES:	    When the client shuts down its end of the connection, it
+ *		    is marked closed. It is dropped by the main loop once its
+ *		    buffered requests have been answered.
+ ***/
+static void fill(struct client * client, uint64_t stamp)
+{
+  while (!client->closed && client->inlen < BUFFER_SIZE) {
+    ssize_t n = read(client->fd, client->in + client->inlen,
+		     BUFFER_SIZE - client->inlen);
+    if (n == -1 && errno == EINTR)
+      continue;
+    if (n == -1 && (errno == EAGAIN || errno == EWOULDBLOCK))
+      return;
+    if (n == 0) {
+      client->closed = 1;
+      return;
+    }
+    if (n == -1) {
+      drop(client);
+      return;
+    }
+    client->inlen += n;
+    scan(client, stamp);
+  }
+}
+
+/*******************************************************************************
+ * FUNCTION:	    scan
+ *
+ * DESCRIPTION:	    Record the arrival time of each request in the input buffer
+ *		    of `client' which has been completed by the last read.
+ *
+ * ARGUMENTS:	    client: (struct client *) -- the client.
+ *		    stamp: (uint64_t) -- the time of the last read.
+ *
+ * RETURN:	    void.
+ *
+ * NOTES:	    Requests which are too large are left for round_batch() to
+ *		    reject.
+ ***/
+static void scan(struct client * client, uint64_t stamp)
+{
+  struct iecd_header header;
+  while (client->inlen - client->scanned >= sizeof(header)) {
+    memcpy(&header, client->in + client->scanned, sizeof(header));
+    if (header.count > IECD_MAX_COUNT)
+      return;
+
+    size_t size = sizeof(header) + header.count * sizeof(double);
+    if (client->inlen - client->scanned < size)
+      return;
+    client->arrivals[client->narrivals++] = stamp;
+    client->scanned += size;
+  }
+}
+
+/*******************************************************************************
+ * FUNCTION:	    flush
+ *
+ * DESCRIPTION:	    Write as much of the output buffer of `client' as the
+ *		    socket will take.
+ *
+ * ARGUMENTS:	    client: (struct client *) -- the client.
+ *
+ * RETURN:	    void.
+ *
+ * NOTES:	    The client is dropped if the write fails.
+ ***/
+static void flush(struct client * client)
+{
+  while (client->outpos < client->outlen) {
+    ssize_t n = send(client->fd, client->out + client->outpos,
+		     client->outlen - client->outpos, MSG_NOSIGNAL);
+    if (n == -1 && errno == EINTR)
+      continue;
+    if (n == -1 && (errno == EAGAIN || errno == EWOULDBLOCK))
+      return;
+    if (n == -1) {
+      drop(client);
+      return;
+    }
+    client->outpos += n;
+  }
+  client->outpos = client->outlen = 0;
+}
+
+/*******************************************************************************
+ * FUNCTION:	    round_batch
+ *
+ * DESCRIPTION:	    Collect the complete requests from every client, round
+ *		    them, and queue the responses.
+ *
+ * ARGUMENTS:	    none.
+ *
+ * RETURN:	    int -- 1 if complete requests were left for the next round,
+ *		    0 otherwise.
+ *
+ * NOTES:	    Requests are sorted by series and direction, so that each
+ *		    group is rounded with one call to iec_eserd_batch().
+ *		    Responses are queued in the order the requests arrived. A
+ *		    request is only taken if there is room in the client's
+ *		    output buffer for its response.
+ ***/
+static int round_batch(void)
+{
+  size_t njobs = 0, nvalues = 0;
+  int backlog = 0;
+  for (int i = 0; i < MAX_CLIENTS; i++) {
+    struct client * client = &clients[i];
+    if (client->fd == -1)
+      continue;
+    if (client->outpos > 0) {
+      memmove(client->out, client->out + client->outpos,
+	      client->outlen - client->outpos);
+      client->outlen -= client->outpos;
+      client->outpos = 0;
+    }
+
+    size_t position = 0, reserved = client->outlen, index = 0;
+    struct iecd_header header;
+    while (client->inlen - position >= sizeof(header)) {
+      memcpy(&header, client->in + position, sizeof(header));
+      if (header.count > IECD_MAX_COUNT) {
+	drop(client);
+	break;
+      }
+
+      size_t size = sizeof(header) + header.count * sizeof(double);
+      if (client->inlen - position < size)
+	break;
+      if (reserved + size > BUFFER_SIZE)
+	break; /* Wait for the client to read its responses */
+      if (njobs == MAX_JOBS || nvalues + header.count > MAX_VALUES) {
+	backlog = 1;
+	break;
+      }
+
+      jobs[njobs].client = client;
+      jobs[njobs].header = header;
+      jobs[njobs].position = position + sizeof(header);
+      jobs[njobs].index = index;
+      jobs[njobs].stamp = client->arrivals[index++];
+      order[njobs] = &jobs[njobs];
+      njobs++;
+      nvalues += header.count;
+      reserved += size;
+      position += size;
+    }
+  }
+
+  /* Pack the values so that each group is contiguous, and round each group */
+  qsort(order, njobs, sizeof(order[0]), compare);
+  nvalues = 0;
+  for (size_t i = 0; i < njobs; i++) {
+    struct job * job = order[i];
+    job->offset = nvalues;
+    if (job->client->fd != -1)
+      memcpy(batchin + nvalues, job->client->in + job->position,
+	     job->header.count * sizeof(double));
+    nvalues += job->header.count;
+  }
+
+  for (size_t i = 0, j = 0; i < njobs; i = j) {
+    size_t count = 0;
+    for (j = i; j < njobs && !compare(&order[i], &order[j]); j++)
+      count += order[j]->header.count;
+    if (iec_eserd_batch(batchin + order[i]->offset, batchout + order[i]->offset,
+			count, order[i]->header.series,
+			order[i]->header.direction) == 0) {
+      for (size_t k = 0; k < count; k++)
+	batchout[order[i]->offset + k] = -1.0;
+    }
+    total.batches++;
+    interval.batches++;
+  }
+
+  /* Queue the responses, and discard the requests */
+  uint64_t t = now();
+  for (size_t i = 0; i < njobs; i++) {
+    struct job * job = &jobs[i];
+    struct client * client = job->client;
+    if (client->fd == -1)
+      continue;
+
+    job->header.latency = t - job->stamp;
+    memcpy(client->out + client->outlen, &job->header, sizeof(job->header));
+    client->outlen += sizeof(job->header);
+    memcpy(client->out + client->outlen, batchout + job->offset,
+	   job->header.count * sizeof(double));
+    client->outlen += job->header.count * sizeof(double);
+
+    struct stats * stats[] = { &total, &interval };
+    for (int k = 0; k < 2; k++) {
+      stats[k]->requests++;
+      stats[k]->values += job->header.count;
+      stats[k]->latency += job->header.latency;
+      if (job->header.latency > stats[k]->maxlatency)
+	stats[k]->maxlatency = job->header.latency;
+    }
+
+    if (i + 1 == njobs || jobs[i + 1].client != client) {
+      size_t consumed = job->position + job->header.count * sizeof(double);
+      memmove(client->in, client->in + consumed, client->inlen - consumed);
+      client->inlen -= consumed;
+      client->scanned -= consumed;
+
+      size_t taken = job->index + 1;
+      memmove(client->arrivals, client->arrivals + taken,
+	      (client->narrivals - taken) * sizeof(uint64_t));
+      client->narrivals -= taken;
+    }
+  }
+
+  return backlog;
+}
+
+/*******************************************************************************
+ * FUNCTION:	    compare
+ *
+ * DESCRIPTION:	    qsort() comparison function which orders jobs by series,
+ *		    then direction, then arrival.
+ *
+ * ARGUMENTS:	    a: (const void *) -- pointer to the first struct job *.
+ *		    b: (const void *) -- pointer to the second struct job *.
+ *
+ * RETURN:	    int -- less than, equal to, or greater than zero.
+ *
+ * NOTES:	    Jobs with the same parameters compare equal. Responses are
+ *		    queued from the unsorted array, so qsort() need not be
+ *		    stable.
+ ***/
+static int compare(const void * a, const void * b)
+{
+  const struct job * x = *(struct job * const *)a;
+  const struct job * y = *(struct job * const *)b;
+  if (x->header.series != y->header.series)
+    return x->header.series < y->header.series ? -1 : 1;
+  if (x->header.direction != y->header.direction)
+    return x->header.direction < y->header.direction ? -1 : 1;
+  return 0;
+}
+
+/*******************************************************************************
+ * FUNCTION:	    report
+ *
+ * DESCRIPTION:	    Print latency and throughput figures to stderr.
+ *
+ * ARGUMENTS:	    stats: (const struct stats *) -- the figures.
+ *		    elapsed: (uint64_t) -- the period they cover, in
+ *			nanoseconds.
+ *		    label: (const char *) -- a description of the period.
+ *
+ * RETURN:	    void.
+ *
+ * NOTES:	    none.
+ ***/
+static void report(const struct stats * stats, uint64_t elapsed,
+		   const char * label)
+{
+  double seconds = elapsed / 1e9;
+  double mean = stats->requests
+    ? (double)stats->latency / stats->requests / 1e3 : 0.0;
+  fprintf(stderr, "iecd: %s: %llu requests, %llu values in %llu batches "
+	  "(%.0f requests/s, %.0f values/s); latency mean %.1f us, "
+	  "max %.1f us\n", label, (unsigned long long)stats->requests,
+	  (unsigned long long)stats->values,
+	  (unsigned long long)stats->batches,
+	  seconds > 0 ? stats->requests / seconds : 0.0,
+	  seconds > 0 ? stats->values / seconds : 0.0,
+	  mean, stats->maxlatency / 1e3);
+}
+
+/*******************************************************************************
+ * FUNCTION:	    now
+ *
+ * DESCRIPTION:	    Read the monotonic clock.
+ *
+ * ARGUMENTS:	    none.
+ *
+ * RETURN:	    uint64_t -- the time, in nanoseconds.
+ *
+ * NOTES:	    none.
+ ***/
+static uint64_t now(void)
+{
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+/******************************************************************************/
@@ -0,0 +1,98 @@
+/*******************************************************************************
+ * NAME:	    iecd.h
+ *
+ * AUTHOR:	    Ethan D. Twardy
+ *
+ * DESCRIPTION:	    This file contains the protocol spoken by the rounding
+ *		    daemon, iecd, and the public interface for the client
+ *		    library in iecdclient.c. Clients send arrays of values over
+ *		    a Unix domain socket, and the daemon rounds the requests
+ *		    from all of its clients together in large batches.
+ *
+ * CREATED:	    10/19/2026
+ *
+ * LAST EDITED:	    10/19/2026
+ ***/
+
+#ifndef __IECD_H__
+#define __IECD_H__
+
+/*******************************************************************************
+ * INCLUDES
+ ***/
+
+#include <stddef.h>
+#include <stdint.h>
+
+/*******************************************************************************
+ * MACRO DEFINITIONS
+ ***/
+
+#define IECD_SOCKET	"/tmp/iecd.sock"
+
+/* The largest number of values in a single request. Larger arrays are split
+ * into several requests by iecd_round().
+ */
+#define IECD_MAX_COUNT	4096
+
+/* The number of requests iecd_round() keeps in flight on one connection */
+#define IECD_WINDOW	2
+
+/*******************************************************************************
+ * TYPE DEFINITIONS
+ ***/
+
+/* Every request and response begins with this header, and is followed by
+ * `count' doubles. All fields are in host byte order. Requests may be sent
+ * without waiting for the response to the previous one; responses carry the
+ * `id' of their request, and are sent in the order the requests arrived.
+ */
+struct iecd_header {
+  uint32_t id;
+  uint32_t count;
+  int32_t series;	/* One of the E series macros in iec60062.h */
+  int32_t direction;	/* One of the direction macros in iec60062.h */
+  uint64_t latency;	/* Response only: nanoseconds from the arrival of the
+			   request to the response being queued */
+};
+
+/* Latency and throughput figures, accumulated by iecd_round() */
+struct iecd_stats {
+  uint64_t requests;
+  uint64_t values;
+  uint64_t latency;	/* Total round trip time, in nanoseconds */
+  uint64_t maxlatency;	/* Longest round trip, in nanoseconds */
+  uint64_t daemon;	/* Total time spent in the daemon, in nanoseconds */
+};
+
+/*******************************************************************************
+ * API FUNCTION PROTOTYPES
+ ***/
+
+/**
+ * Connect to the daemon listening on `path.' Returns a socket, or -1.
+ */
+extern int iecd_connect(const char * path);
+
+/**
+ * Send one request of at most IECD_MAX_COUNT values. Returns 0, or -1.
+ */
+extern int iecd_submit(int fd, uint32_t id, const double * values,
+		       uint32_t count, int series, int direction);
+
+/**
+ * Wait for the next response. Returns 0, or -1.
+ */
+extern int iecd_receive(int fd, struct iecd_header * header, double * rounded,
+			uint32_t max);
+
+/**
+ * Round `count' values using E series `series,' through the daemon.
+ */
+extern int iecd_round(int fd, const double * values, double * rounded,
+		      size_t count, int series, int direction,
+		      struct iecd_stats * stats);
+
+#endif /* __IECD_H__ */
+
+/******************************************************************************/
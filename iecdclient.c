@@ -0,0 +1,305 @@
+/*******************************************************************************
+ * NAME:	    iecdclient.c
+ *
+ * AUTHOR:	    Ethan D. Twardy
+ *
+ * DESCRIPTION:	    This file contains the client library for the rounding
+ *		    daemon, iecd. See iecd.h for the protocol.
+ *
+ * CREATED:	    10/19/2026
+ *
+ * LAST EDITED:	    10/19/2026
+ ***/
+
+/*******************************************************************************
+ * INCLUDES
+ ***/
+
+#include <string.h>
+#include <errno.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+
+#include "iecd.h"
+
+/*******************************************************************************
+ * STATIC FUNCTION PROTOTYPES
+ ***/
+
+static int readall(int fd, void * buffer, size_t length);
+static int writeall(int fd, const void * buffer, size_t length);
+static uint64_t now(void);
+
+/*******************************************************************************
+ * API FUNCTIONS
+ ***/
+
+/*******************************************************************************
+ * FUNCTION:	    iecd_connect
+ *
+ * DESCRIPTION:	    Connect to the daemon listening on the Unix domain socket
+ *		    at `path.'
+ *
+ * ARGUMENTS:	    path: (const char *) -- the path of the socket, or NULL to
+ *			use IECD_SOCKET.
+ *
+ * RETURN:	    int -- the connected socket, or -1 if an error occurred, in
+ *		    which case errno is set.
+ *
+ * NOTES:	    The socket should be closed with close() after use.
+ ***/
+int iecd_connect(const char * path)
+{
+  struct sockaddr_un addr;
+  if (path == NULL)
+    path = IECD_SOCKET;
+  if (strlen(path) >= sizeof(addr.sun_path)) {
+    errno = ENAMETOOLONG;
+    return -1;
+  }
+
+  memset(&addr, 0, sizeof(addr));
+  addr.sun_family = AF_UNIX;
+  strcpy(addr.sun_path, path);
+
+  int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+  if (fd == -1)
+    return -1;
+  if (connect(fd, (struct sockaddr *)&addr, sizeof(addr)) == -1) {
+    int error = errno;
+    close(fd);
+    errno = error;
+    return -1;
+  }
+
+  return fd;
+}
+
+/*******************************************************************************
+ * FUNCTION:	    iecd_submit
+ *
+ * DESCRIPTION:	    Send a request to round the `count' values in `values'
+ *		    using E series `series.'
+ *
+ * ARGUMENTS:	    fd: (int) -- the socket returned by iecd_connect().
+ *		    id: (uint32_t) -- the id, which is returned in the response.
+ *		    values: (const double *) -- the values to round.
+ *		    count: (uint32_t) -- the number of values. At most
+ *			IECD_MAX_COUNT.
+ *		    series: (int) -- the series to use. One of macros defined in
+ *			iec60062.h.
+ *		    direction: (int) -- the direction to round in. One of macros
+ *			defined in iec60062.h.
+ *
+ * RETURN:	    int -- 0 on success, -1 if an error occurred.
+ *
+ * NOTES:	    Several requests may be submitted before receiving the
+ *		    responses, but the daemon stops reading from a client whose
+ *		    responses are not being read.
+ ***/
+int iecd_submit(int fd, uint32_t id, const double * values, uint32_t count,
+		int series, int direction)
+{
+  if (count > IECD_MAX_COUNT || (values == NULL && count > 0)) {
+    errno = EINVAL;
+    return -1;
+  }
+
+  struct iecd_header header;
+  memset(&header, 0, sizeof(header));
+  header.id = id;
+  header.count = count;
+  header.series = series;
+  header.direction = direction;
+  if (writeall(fd, &header, sizeof(header))
+      || writeall(fd, values, count * sizeof(double)))
+    return -1;
+  return 0;
+}
+
+/*******************************************************************************
+ * FUNCTION:	    iecd_receive
+ *
+ * DESCRIPTION:	    Wait for the next response from the daemon.
+ *
+ * ARGUMENTS:	    fd: (int) -- the socket returned by iecd_connect().
+ *		    header: (struct iecd_header *) -- location to place the
+ *			header of the response.
+ *		    rounded: (double *) -- location to place the rounded values.
+ *			Values which could not be rounded are set to -1.
+ *		    max: (uint32_t) -- the number of values `rounded' can hold.
+ *
+ * RETURN:	    int -- 0 on success, -1 if an error occurred.
+ *
+ * NOTES:	    none.
+ ***/
+int iecd_receive(int fd, struct iecd_header * header, double * rounded,
+		 uint32_t max)
+{
+  if (header == NULL || readall(fd, header, sizeof(*header)))
+    return -1;
+  if (header->count > max || (rounded == NULL && header->count > 0)) {
+    errno = EMSGSIZE;
+    return -1;
+  }
+  return readall(fd, rounded, header->count * sizeof(double));
+}
+
+/*******************************************************************************
+ * FUNCTION:	    iecd_round
+ *
+ * DESCRIPTION:	    Round each of the `count' values in `values' using the IEC
+ *		    E series `series,' through the daemon, and place the results
+ *		    in `rounded.'
+ *
+ * ARGUMENTS:	    fd: (int) -- the socket returned by iecd_connect().
+ *		    values: (const double *) -- the values to round.
+ *		    rounded: (double *) -- location to place the rounded values.
+ *			Values which could not be rounded are set to -1.
+ *		    count: (size_t) -- the number of values in each array.
+ *		    series: (int) -- the series to use. One of macros defined in
+ *			iec60062.h.
+ *		    direction: (int) -- the direction to round in. One of macros
+ *			defined in iec60062.h.
+ *		    stats: (struct iecd_stats *) -- latency and throughput
+ *			figures are added to this struct. May be NULL.
+ *
+ * RETURN:	    int -- 0 on success, -1 if an error occurred.
+ *
+ * NOTES:	    The values are sent in requests of IECD_MAX_COUNT values,
+ *		    with up to IECD_WINDOW requests in flight at once.
+ ***/
+int iecd_round(int fd, const double * values, double * rounded, size_t count,
+	       int series, int direction, struct iecd_stats * stats)
+{
+  size_t requests = (count + IECD_MAX_COUNT - 1) / IECD_MAX_COUNT;
+  size_t sent = 0, received = 0;
+  uint64_t start[IECD_WINDOW];
+  struct iecd_header header;
+  if (values == NULL || rounded == NULL) {
+    errno = EINVAL;
+    return -1;
+  }
+
+  while (received < requests) {
+    while (sent < requests && sent - received < IECD_WINDOW) {
+      size_t offset = sent * IECD_MAX_COUNT;
+      size_t n = count - offset < IECD_MAX_COUNT
+	? count - offset : IECD_MAX_COUNT;
+      start[sent % IECD_WINDOW] = now();
+      if (iecd_submit(fd, (uint32_t)sent, values + offset, (uint32_t)n,
+		      series, direction))
+	return -1;
+      sent++;
+    }
+
+    size_t offset = received * IECD_MAX_COUNT;
+    size_t n = count - offset < IECD_MAX_COUNT
+      ? count - offset : IECD_MAX_COUNT;
+    if (iecd_receive(fd, &header, rounded + offset, (uint32_t)n))
+      return -1;
+    if (header.id != (uint32_t)received || header.count != n) {
+      errno = EPROTO;
+      return -1;
+    }
+
+    if (stats != NULL) {
+      uint64_t latency = now() - start[received % IECD_WINDOW];
+      stats->requests++;
+      stats->values += header.count;
+      stats->latency += latency;
+      stats->daemon += header.latency;
+      if (latency > stats->maxlatency)
+	stats->maxlatency = latency;
+    }
+    received++;
+  }
+
+  return 0;
+}
+
+/*******************************************************************************
+ * STATIC FUNCTIONS
+ ***/
+
+/*******************************************************************************
+ * FUNCTION:	    readall
+ *
+ * DESCRIPTION:	    Read exactly `length' bytes from `fd' into `buffer.'
+ *
+ * ARGUMENTS:	    fd: (int) -- the file descriptor to read from.
+ *		    buffer: (void *) -- location to place the data.
+ *		    length: (size_t) -- the number of bytes to read.
+ *
+ * RETURN:	    int -- 0 on success, -1 if an error occurred or the
+ *		    connection was closed.
+ *
+ * NOTES:	    none.
+ ***/
+static int readall(int fd, void * buffer, size_t length)
+{
+  char * p = buffer;
+  while (length > 0) {
+    ssize_t n = read(fd, p, length);
+    if (n == -1 && errno == EINTR)
+      continue;
+    if (n <= 0) {
+      if (n == 0)
+	errno = ECONNRESET;
+      return -1;
+    }
+    p += n;
+    length -= n;
+  }
+  return 0;
+}
+
+/*******************************************************************************
+ * FUNCTION:	    writeall
+ *
+ * DESCRIPTION:	    Write exactly `length' bytes from `buffer' to `fd.'
+ *
+ * ARGUMENTS:	    fd: (int) -- the file descriptor to write to.
+ *		    buffer: (const void *) -- the data.
+ *		    length: (size_t) -- the number of bytes to write.
+ *
+ * RETURN:	    int -- 0 on success, -1 if an error occurred.
+ *
+ * NOTES:	    none.
+ ***/
+static int writeall(int fd, const void * buffer, size_t length)
+{
+  const char * p = buffer;
+  while (length > 0) {
+    ssize_t n = send(fd, p, length, MSG_NOSIGNAL);
+    if (n == -1 && errno == EINTR)
+      continue;
+    if (n == -1)
+      return -1;
+    p += n;
+    length -= n;
+  }
+  return 0;
+}
+
+/*******************************************************************************
+ * FUNCTION:	    now
+ *
+ * DESCRIPTION:	    Read the monotonic clock.
+ *
+ * ARGUMENTS:	    none.
+ *
+ * RETURN:	    uint64_t -- the time, in nanoseconds.
+ *
+ * NOTES:	    none.
+ ***/
+static uint64_t now(void)
+{
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+/******************************************************************************/
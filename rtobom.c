@@ -0,0 +1,45 @@
+/*******************************************************************************
+ * NAME:	    rtobom.c
+ *
+ * AUTHOR:	    Ethan D. Twardy
+ *
+ * DESCRIPTION:	    Convert a text file of component values in "R" notation,
+ *		    one per line, to the columnar binary BOM format described
+ *		    in iecbom.h.
+ *
+ * CREATED:	    10/19/2026
+ *
+ * LAST EDITED:	    10/19/2026
+ ***/
+
+/*******************************************************************************
+ * INCLUDES
+ ***/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+
+#include "iecbom.h"
+#include "error.h"
+
+/*******************************************************************************
+ * MAIN
+ ***/
+
+int main(int argc, char * argv[]) {
+
+  StopIf(argc != 3, 1, "Usage: %s <text> <binary>\n", argv[0]);
+
+  size_t line = 0;
+  long count = iec_bom_convert(argv[1], argv[2], &line);
+  StopIf(count < 0 && line > 0, 1, ERROR_PRINT"%s:%zu: invalid \"R\" "
+	 "notation\n", argv[1], line);
+  StopIf(count < 0, 1, ERROR_PRINT"%s\n", strerror(errno));
+
+  printf("%ld components written to %s\n", count, argv[2]);
+  return 0;
+}
+
+/******************************************************************************/
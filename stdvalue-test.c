@@ -56,8 +56,7 @@ int main() {
     StopIf(arr == NULL, 1, "Error: gaussian() returned NULL.\n");
     for (int j = 0; j < arrsize; j++) {
       t = fabsf(arr[j]) + (float)tests[i][0];
-      final = stdvalue(t, (float *)&e48,
-		       sizeof(e48) / sizeof(float), IEC_ROUND_UP);
+      final = stdvalue(t, e48, sizeof(e48) / sizeof(double), IEC_ROUND_UP);
       printf("%d\t\t%8g\t%8g\n", (10*i)+j+1, t, final);
     }
     free(arr);